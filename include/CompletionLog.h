@@ -0,0 +1,132 @@
+#ifndef COMPLETION_LOG_H
+#define COMPLETION_LOG_H
+
+#include "CowVector.h"
+#include "ProcessTable.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Results file of the processes a scheduler retired (see
+ * MLFQScheduler::setSpillFile). Records have a fixed size, so any of them
+ * can be read back by index. Appends are buffered and written a block at a
+ * time, and reads go through a one-block cache, so walking the log in order
+ * costs one file read per BLOCK_RECORDS records.
+ *
+ * On disk the file is a magic tag followed by one record per process: pid,
+ * arrival, burst, completion, turnaround, wait and response time, each as a
+ * little-endian 64-bit integer.
+ *
+ * Copies of the writing scheduler share the log and read its first records.
+ * A writer that rewinds below what a copy reads starts a new file at the
+ * same path with branchFrom(); the old file moves to a temporary name and
+ * is removed with the last copy, as a shared CowVector chunk is copied
+ * rather than written in place.
+ */
+class CompletionLog
+{
+public:
+    static const size_t BLOCK_RECORDS = 1024;
+    static const size_t RECORD_BYTES = 7 * 8;
+
+private:
+    string path;
+    mutable fstream file;
+    size_t written;                         // Records on disk
+    vector<CompletedProcess> pending;       // Records after those, not yet written
+    mutable vector<CompletedProcess> cache; // One block read back from disk
+    mutable size_t cacheStart;
+    size_t sharedCount;                     // Records a copy of the writer may read
+    bool temporary;                         // Moved aside by branchFrom(); removed when destroyed
+
+    void moveAside();
+
+public:
+    CompletionLog();
+    ~CompletionLog();  // Writes out pending records
+    CompletionLog(const CompletionLog&) = delete;
+    CompletionLog& operator=(const CompletionLog&) = delete;
+
+    // Create or truncate the file; false and errorMsg set on failure
+    bool open(const string& filePath, string& errorMsg);
+    bool isOpen() const { return file.is_open(); }
+    const string& getPath() const { return path; }
+
+    void append(const CompletedProcess& record);
+    size_t size() const { return written + pending.size(); }
+
+    // Read a record back; pid is -1 if the file could not be read
+    CompletedProcess operator[](size_t index) const;
+
+    void truncate(size_t records);  // Keep only the first records
+    bool flush();                   // Write pending records now
+
+    // Copies of the writing scheduler report how far they read
+    void share(size_t records) { sharedCount = max(sharedCount, records); }
+    size_t getSharedCount() const { return sharedCount; }
+
+    // Create the file at source's path holding source's first records,
+    // leaving source readable for its copies; false and errorMsg set on
+    // failure, with source unchanged or moved aside
+    bool branchFrom(CompletionLog& source, size_t records, string& errorMsg);
+};
+
+/**
+ * The completed processes of a scheduler: first those retired to its
+ * CompletionLog, then those still held in its ProcessTable, each in
+ * completion order. Yields CompletedProcess records by value.
+ */
+class CompletedRange
+{
+private:
+    const CompletionLog* spilled;          // Null when nothing was spilled
+    size_t spilledCount;
+    const ProcessTable* table;
+    const CowVector<ProcessSlot>* held;
+
+public:
+    class iterator
+    {
+    private:
+        const CompletedRange* range;
+        size_t index;
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef CompletedProcess value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const CompletedProcess* pointer;
+        typedef CompletedProcess reference;
+
+        iterator(const CompletedRange* r, size_t i) : range(r), index(i) {}
+        CompletedProcess operator*() const { return (*range)[index]; }
+        iterator& operator++() { ++index; return *this; }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    };
+
+    CompletedRange(const CompletionLog* log, size_t logCount, const ProcessTable* t, const CowVector<ProcessSlot>* slots)
+        : spilled(log), spilledCount(logCount), table(t), held(slots) {}
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, size()); }
+    size_t size() const { return spilledCount + held->size(); }
+    bool empty() const { return size() == 0; }
+
+    CompletedProcess operator[](size_t index) const
+    {
+        if (index < spilledCount)
+        {
+            return (*spilled)[index];
+        }
+        return table->completed((*held)[index - spilledCount]);
+    }
+    CompletedProcess front() const { return (*this)[0]; }
+    CompletedProcess back() const { return (*this)[size() - 1]; }
+};
+
+#endif // COMPLETION_LOG_H
@@ -0,0 +1,159 @@
+#ifndef COW_VECTOR_H
+#define COW_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+using namespace std;
+
+/**
+ * Vector whose elements live in fixed-size chunks shared between copies.
+ * Copying costs one pointer per chunk; a write clones only the chunk it
+ * lands in, and only while another copy still shares that chunk. Used for
+ * the scheduler state that snapshots have to capture cheaply.
+ */
+template <class T, size_t ChunkShift = 10>
+class CowVector
+{
+public:
+    static const size_t CHUNK_SIZE = size_t(1) << ChunkShift;
+
+    class const_iterator
+    {
+    private:
+        const CowVector* owner;
+        size_t index;
+
+    public:
+        typedef random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator(const CowVector* o = nullptr, size_t i = 0) : owner(o), index(i) {}
+        const T& operator*() const { return (*owner)[index]; }
+        const T* operator->() const { return &(*owner)[index]; }
+        const T& operator[](ptrdiff_t n) const { return (*owner)[index + n]; }
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator& operator--() { --index; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++index; return old; }
+        const_iterator operator--(int) { const_iterator old = *this; --index; return old; }
+        const_iterator& operator+=(ptrdiff_t n) { index += n; return *this; }
+        const_iterator& operator-=(ptrdiff_t n) { index -= n; return *this; }
+        const_iterator operator+(ptrdiff_t n) const { return const_iterator(owner, index + n); }
+        const_iterator operator-(ptrdiff_t n) const { return const_iterator(owner, index - n); }
+        ptrdiff_t operator-(const const_iterator& other) const { return static_cast<ptrdiff_t>(index) - static_cast<ptrdiff_t>(other.index); }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+        bool operator<(const const_iterator& other) const { return index < other.index; }
+        bool operator>(const const_iterator& other) const { return index > other.index; }
+        bool operator<=(const const_iterator& other) const { return index <= other.index; }
+        bool operator>=(const const_iterator& other) const { return index >= other.index; }
+    };
+
+private:
+    typedef array<T, CHUNK_SIZE> Chunk;
+
+    vector<shared_ptr<Chunk>> chunks;   // Allocated chunks, kept across clear()
+    size_t count;
+
+    static size_t offset(size_t index) { return index & (CHUNK_SIZE - 1); }
+
+public:
+    CowVector() : count(0) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return chunks.size() * CHUNK_SIZE; }
+
+    const T& operator[](size_t index) const { return (*chunks[index >> ChunkShift])[offset(index)]; }
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[count - 1]; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+    // Writable access; clones the element's chunk if a copy shares it
+    T& at(size_t index)
+    {
+        shared_ptr<Chunk>& chunk = chunks[index >> ChunkShift];
+        if (chunk.use_count() > 1)
+        {
+            chunk = make_shared<Chunk>(*chunk);
+        }
+        return (*chunk)[offset(index)];
+    }
+    T& mutableBack() { return at(count - 1); }
+
+    void push_back(const T& value)
+    {
+        if (count == capacity())
+        {
+            chunks.push_back(shared_ptr<Chunk>(new Chunk));
+        }
+        else if (!chunks[count >> ChunkShift])
+        {
+            chunks[count >> ChunkShift].reset(new Chunk);  // Discarded before a clear()
+        }
+        at(count++) = value;
+    }
+
+    // Same as push_back() of each value, copying a chunk at a time
+    void append(const T* values, size_t n)
+    {
+        while (n > 0)
+        {
+            if (count == capacity())
+            {
+                chunks.push_back(shared_ptr<Chunk>(new Chunk));
+            }
+            else if (!chunks[count >> ChunkShift])
+            {
+                chunks[count >> ChunkShift].reset(new Chunk);
+            }
+            size_t take = min(n, CHUNK_SIZE - offset(count));
+            copy(values, values + take, &at(count));
+            count += take;
+            values += take;
+            n -= take;
+        }
+    }
+
+    void pop_back() { count--; }
+
+    // Shifts the tail up by one; cheap when index is at or near the end
+    void insert(size_t index, const T& value)
+    {
+        push_back(value);
+        for (size_t i = count - 1; i > index; i--)
+        {
+            at(i) = (*this)[i - 1];
+        }
+        at(index) = value;
+    }
+
+    void reserve(size_t elements)
+    {
+        while (capacity() < elements)
+        {
+            chunks.push_back(shared_ptr<Chunk>(new Chunk));
+        }
+    }
+
+    void clear() { count = 0; }   // O(1); chunks are reused
+
+    // Free the chunks lying wholly before index, whose elements must not be
+    // read again; indices stay as they were. Copies sharing a chunk keep it
+    void discardBefore(size_t index)
+    {
+        for (size_t c = index >> ChunkShift; c-- > 0 && chunks[c]; )
+        {
+            chunks[c].reset();
+        }
+    }
+};
+
+#endif // COW_VECTOR_H
@@ -38,13 +38,8 @@ private:
     string statsText;
     string ganttText;
     
-    // Store initial process configuration for reset
-    struct ProcessConfig 
-    {
-        int arrivalTime;
-        int burstTime;
-    };
-    vector<ProcessConfig> initialProcesses;
+    // Scheduler state at startup, restored by reset
+    SchedulerSnapshot initialState;
     
     // Update methods
     void updateQueueDisplays();
@@ -65,8 +60,8 @@ public:
     
     void run();  // Main GUI loop
     void updateDisplay();
-    void saveInitialProcesses();  // Save processes for reset
-    void restoreInitialProcesses();  // Restore processes after reset
+    void saveInitialProcesses();  // Snapshot the scheduler for reset
+    void restoreInitialProcesses();  // Return the scheduler to that snapshot
     
     // Static callback handlers
     void handleStep();
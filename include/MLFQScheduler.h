@@ -1,11 +1,16 @@
 #ifndef MLFQ_SCHEDULER_H
 #define MLFQ_SCHEDULER_H
 
+#include "CompletionLog.h"
+#include "CowVector.h"
+#include "MpscQueue.h"
 #include "Process.h"
+#include "ProcessTable.h"
 #include "Queue.h"
 #include "SchedulerConfig.h"
-#include <vector>
+#include "SchedulerObserver.h"
 #include <memory>
+#include <vector>
 #include <map>
 using namespace std;
 
@@ -15,46 +20,167 @@ struct SchedulerStats
     double avgTurnaroundTime;
     double avgResponseTime;
     double cpuUtilization;
-    int totalProcesses;
-    int completedProcesses;
-    int currentTime;
+    size_t totalProcesses;
+    size_t completedProcesses;
+    SimTime currentTime;
+    long long cpuBusyTime;      // Time units spent executing processes
+};
+
+// Running totals for one queue level
+struct QueueStats
+{
+    long long busyTime;     // Time units executed by processes dispatched from this level
+    long long dispatches;   // Times a process was dispatched from this level
+};
+
+// Extremes over completed processes; pids are -1 until something completes.
+// Ties go to the process added first
+struct CompletionReport
+{
+    int maxWaitPid;
+    SimTime maxWaitTime;
+    int minTurnaroundPid;
+    SimTime minTurnaroundTime;
+    int maxTurnaroundPid;
+    SimTime maxTurnaroundTime;
+    int maxResponsePid;
+    SimTime maxResponseTime;
+};
+
+// What happens to a process once it completes
+enum class CompletedRetention
+{
+    KEEP,       // Stays in the process table (default)
+    DISCARD,    // Folded into the statistics, then freed
+    SPILL       // Also appended to a results file (setSpillFile) first
+};
+
+// One process of a workload for MLFQScheduler::loadWorkload()
+struct JobSpec
+{
+    SimTime arrivalTime;
+    SimTime burstTime;
+};
+
+// Service order of the last queue for each last-queue algorithm
+QueueOrder queueOrderFor(LastQueueAlgorithm algorithm);
+
+class MLFQScheduler;
+class ReplayLog;
+
+/**
+ * Frozen copy of a scheduler's state, taken by MLFQScheduler::snapshot().
+ * Shares storage with the scheduler it came from until either side writes.
+ */
+class SchedulerSnapshot
+{
+private:
+    shared_ptr<const MLFQScheduler> state;
+    friend class MLFQScheduler;
+
+public:
+    bool empty() const { return !state; }
 };
 
 class MLFQScheduler 
 {
 private:
-    vector<ProcessQueue> readyQueues;
-    vector<shared_ptr<Process>> allProcesses;
-    vector<shared_ptr<Process>> completedProcesses;
-    shared_ptr<Process> currentProcess;
-
-    int currentTime;
-    int boostTimer;
-    int boostInterval;  // Priority boost interval (aging prevention)
+    ProcessTable table;           // Every process added, indexed by slot
+    MultilevelQueue readyQueues;  // Slots into table
+    CowVector<ProcessSlot> completedSlots;  // Completed and not retired
+    ProcessSlot currentSlot;      // NO_PROCESS when the CPU is idle
+
+    // Arrival-ordered slots; entries before the cursor have already been
+    // admitted to the ready queues
+    CowVector<ProcessSlot> arrivalOrder;
+    size_t arrivalCursor;
+    size_t readyCount;  // Processes waiting in the ready queues
+
+    SimTime currentTime;
+    SimTime boostTimer;
+    SimTime boostInterval;  // Priority boost interval (aging prevention)
     int numQueues;
     int pidCounter;     // Process ID counter
     SchedulerConfig config;  // Configuration parameters
     LastQueueAlgorithm lastQueueAlgorithm;  // Algorithm for last queue
+    bool executionLogging;  // Record the Gantt log during bulk runs
+    ReplayLog* recorder;    // Receives every input when set (not copied)
+    SchedulerObserver* observer;  // Receives engine events when set (not copied)
+    unique_ptr<MpscQueue<JobSpec>> submissions;  // Filled by submit() (not copied)
 
+    // Retirement: completed processes leave the table once folded into the
+    // running totals and retiredReport. Only the scheduler that opened the
+    // spill file writes to it; copies read the records spilled before them
+    // and keep their own later completions in the table
+    CompletedRetention retention;
+    shared_ptr<CompletionLog> spill;
+    bool ownsSpill;
+    size_t spilledCount;          // Records of spill that belong to this run
+    size_t retiredCount;
+    CompletionReport retiredReport;
+    size_t cancelledCount;        // Retired by cancelProcess, not counted as completed
 
-    // Execution log for Gantt chart
+    // Execution log for Gantt chart, run-length compressed: consecutive
+    // slices of the same process at the same queue level share one record
     struct ExecutionRecord
     {
         int pid;
-        int startTime;
-        int endTime;
+        SimTime startTime;
+        SimTime endTime;
         int queueLevel;
     };
-    vector<ExecutionRecord> executionLog;
+    CowVector<ExecutionRecord> executionLog;
+
+    // Statistics accumulated as processes run and complete, so getStats() is O(1)
+    long long totalWaitTime;
+    long long totalTurnaroundTime;
+    long long totalResponseTime;
+    long long busyTime;
+    vector<QueueStats> queueStats;
+
+    // The scheduling core is specialized on the last queue's order (a
+    // QueueOrder policy type from Queue.h), on whether it logs and on its
+    // event hooks (SchedulerObserver.h), so each instantiation runs with no
+    // per-tick branching on configuration. The public entry points call the
+    // instantiation matching the current settings through these pointers,
+    // re-selected when the settings change. Templates are in SchedulerEngine.h
+    typedef void (MLFQScheduler::*Engine)(SimTime endTime, bool untilComplete, bool singleEvent);
+    Engine bulkEngine;    // Logs only when executionLogging is set
+    Engine tickEngine;    // Always logs (step, stepEvent)
+    void selectEngines();
+    template <class LastOrder>
+    void selectEnginesFor();
 
     // Helper methods
-    void moveToNextQueue(shared_ptr<Process> process);
-    void insertProcessIntoLastQueueByAlgorithm(shared_ptr<Process> process);
+    void initQueues();
     void boostAllProcesses();
-    void updateWaitTimes();
-    shared_ptr<Process> selectNextProcess();
-    shared_ptr<Process> selectNextProcessForLastQueue();  // Select based on algorithm
-    void checkNewArrivals();
+    void logExecution(int pid, SimTime startTime, SimTime endTime, int queueLevel);
+    void indexArrival(ProcessSlot slot);
+    void drainSubmissions();
+    void retire(ProcessSlot slot);
+    void retireCompleted();          // Retire everything in completedSlots
+    void rewindSpill(size_t records); // Drop spilled records past records (owner only)
+    void noteUnloggedRun();          // Tell the recorder when a bulk run skips the log
+    SimTime nextSliceLength() const; // Time until the next scheduling event
+    SimTime nextArrivalTime() const; // Earliest pending arrival after currentTime (-1 if none)
+    template <class LastOrder>
+    void makeReady(int level, ProcessSlot slot, SimTime enterTime);
+    template <class LastOrder, class Hooks>
+    void moveToNextQueue(Hooks& hooks, ProcessSlot slot);
+    template <class LastOrder>
+    ProcessSlot selectNextProcess();
+    template <class LastOrder, class Hooks>
+    void checkNewArrivals(Hooks& hooks);
+    template <class LastOrder, class Hooks>
+    bool dispatchIfIdle(Hooks& hooks);           // Select a process if the CPU is free
+    template <bool LogExecution, class LastOrder, class Hooks>
+    void runSlice(Hooks& hooks, SimTime timeSlice); // Execute current process for timeSlice units
+    template <bool LogExecution, class LastOrder, class Hooks>
+    void runLoop(Hooks& hooks, SimTime endTime, bool untilComplete, bool singleEvent);
+    template <bool LogExecution, class LastOrder, bool Observed>
+    void runEngine(SimTime endTime, bool untilComplete, bool singleEvent);
+    template <class Hooks>
+    void runWithHooks(Hooks& hooks, SimTime endTime, bool untilComplete);
 
 public:
     // Algorithm selection methods
@@ -63,45 +189,150 @@ public:
 
     // AI-related helper methods
     void adaptiveParameterUpdate();
-    void recordSchedulingDecision(shared_ptr<Process> process, int decision);
 
 public:
     // Constructors
     MLFQScheduler(int queues = 3, int boost = 100);  // Legacy constructor
     MLFQScheduler(const SchedulerConfig& cfg);        // Configuration-based constructor
 
+    // Copies rebind the queues to the copy's own process table. Process,
+    // queue and log storage is copy-on-write, so a copy costs O(chunks)
+    MLFQScheduler(const MLFQScheduler& other);
+    MLFQScheduler& operator=(const MLFQScheduler& other);
+
+    // What-if branching: snapshot() freezes the current state, restore()
+    // returns to it, and fork() starts an independent scheduler from here.
+    // A rewind cannot be replayed, so restore() marks any attached recording
+    // incomplete and detaches it
+    SchedulerSnapshot snapshot() const;
+    void restore(const SchedulerSnapshot& snap);
+    MLFQScheduler fork() const { return MLFQScheduler(*this); }
+
     // Destructor
     ~MLFQScheduler();
 
     // Process management
-    void addProcess(int arrivalTime, int burstTime);
-    void addProcess(shared_ptr<Process> process);
+    void addProcess(SimTime arrivalTime, SimTime burstTime);
+    void addProcess(const Process& process);  // Copies arrival and burst; PID is assigned
+    void reserve(size_t processes);           // Preallocate storage for a workload
+
+    // Add many processes at once, in any arrival order. Same result as
+    // calling addProcess() for each job in turn (pids follow the input), but
+    // storage is reserved once and the arrival index is built by one radix
+    // sort and a single merge pass instead of an insertion per job
+    void loadWorkload(const JobSpec* jobs, size_t count);
+    void loadWorkload(const vector<JobSpec>& jobs) { loadWorkload(jobs.data(), jobs.size()); }
+
+    // The one member that is safe to call from other threads, any number at
+    // once, while the scheduler runs: lock-free, and it never waits for the
+    // simulation. The job is added as by addProcess() at the start of the
+    // next step(), stepEvent() or event of a bulk run, at the clock of that
+    // moment; an arrival time already past is admitted then
+    void submit(SimTime arrivalTime, SimTime burstTime) { submissions->push(JobSpec{arrivalTime, burstTime}); }
+    // Add the jobs submitted so far now (scheduler thread only)
+    void acceptSubmissions()
+    {
+        if (submissions->hasPending())
+        {
+            drainSubmissions();
+        }
+    }
+
+    // Control by pid, each O(1): pids are numbered in table slot order, so
+    // the process table doubles as the pid index (ProcessTable::findPid).
+    // Retired and cancelled pids are not found
+    ProcessView findProcess(int pid) const;
+    bool cancelProcess(int pid);                // Drop a process wherever it is
+    bool setBurst(int pid, SimTime burstTime);  // Must exceed the CPU time already used
+    size_t getCancelledCount() const { return cancelledCount; }
 
     // Scheduling
-    void step();  // Execute one time unit
+    void step();       // Execute one time unit
+    void stepEvent();  // Jump to the next arrival, quantum expiry, completion or boost
+
+    // Bulk execution: event-driven internal loops whose schedule is identical
+    // to calling step() repeatedly (each step() advances time by one unit)
+    void runUntil(SimTime time);  // Run until getCurrentTime() reaches time
+    void runSteps(SimTime steps); // Same as calling step() steps times
+    void runToCompletion();       // Run until isComplete()
+    void setExecutionLogging(bool enabled);  // Bulk runs only
+
+    // The same bulk runs with compile-time hooks: Hooks has the member
+    // functions of SchedulerObserver (derive from NoSchedulerHooks) and is
+    // called inline from the engine, in place of any runtime observer.
+    // Include SchedulerEngine.h to use these
+    template <class Hooks>
+    void runUntil(SimTime time, Hooks& hooks);
+    template <class Hooks>
+    void runToCompletion(Hooks& hooks);
+    bool isExecutionLogging() const { return executionLogging; }
     bool hasProcesses() const;
     bool isComplete() const;
 
 
     // Getters
-    int getCurrentTime() const { return currentTime; }
-    shared_ptr<Process> getCurrentProcess() const { return currentProcess; }
-    const vector<ProcessQueue>& getQueues() const { return readyQueues; }
-    const vector<shared_ptr<Process>>& getAllProcesses() const { return allProcesses; }
-    const vector<shared_ptr<Process>>& getCompletedProcesses() const { return completedProcesses; }
+    SimTime getCurrentTime() const { return currentTime; }
+    ProcessView getCurrentProcess() const { return currentSlot == NO_PROCESS ? ProcessView() : table.view(currentSlot); }
+    const vector<ProcessQueue>& getQueues() const { return readyQueues.getLevels(); }
+    // Processes still in the table; retired ones are left out
+    ProcessRange<LiveSlotCounter> getAllProcesses() const
+    {
+        return ProcessRange<LiveSlotCounter>(&table, LiveSlotCounter(&table, 0),
+                                             LiveSlotCounter(&table, static_cast<ProcessSlot>(table.size())), table.liveCount());
+    }
+    // Spilled processes read back from the file, then those still held
+    CompletedRange getCompletedProcesses() const
+    {
+        return CompletedRange(spill.get(), spilledCount, &table, &completedSlots);
+    }
+    const ProcessTable& getProcessTable() const { return table; }
 
     // Statistics
     SchedulerStats getStats() const;
+    const vector<QueueStats>& getQueueStats() const { return queueStats; }
+    CompletionReport getCompletionReport() const;  // Vectorized once every process completed
 
-    // Reset
+    // Reset (O(1) in the number of processes; storage is kept for reuse)
     void reset();
 
-    // Get execution log for visualization
-    const vector<ExecutionRecord>& getExecutionLog() const { return executionLog; }
+    // Get execution log for visualization (one record per contiguous span)
+    const CowVector<ExecutionRecord>& getExecutionLog() const { return executionLog; }
+
+    // Expand the log back into one record per executed time unit
+    vector<ExecutionRecord> getExecutionTicks() const;
 
     // Get configuration
     const SchedulerConfig& getConfig() const { return config; }
 
+    // Record every input (processes, algorithm and boost interval changes)
+    // into log, starting from the current configuration; null stops
+    // recording. Attach before adding processes; reset() restarts the log.
+    // Replays are checked against the execution log, so a bulk run with
+    // setExecutionLogging(false) marks the recording incomplete
+    void setRecorder(ReplayLog* log);
+    ReplayLog* getRecorder() const { return recorder; }
+
+    // Report arrivals, dispatches, preemptions, demotions, boosts and
+    // completions to obs as the engine makes them, in every run and step;
+    // null detaches. Without an observer the engine has no hook calls at all
+    void setObserver(SchedulerObserver* obs);
+    SchedulerObserver* getObserver() const { return observer; }
+
+    // Retention of completed processes. Choosing DISCARD retires the ones
+    // kept so far; setSpillFile() creates the results file, selects SPILL
+    // and spills them. reset() keeps the policy and rewinds the file, or
+    // starts it afresh while snapshots still read the old records. The
+    // execution log is not covered: it keeps every span of every process,
+    // so long runs should also call setExecutionLogging(false)
+    void setRetention(CompletedRetention policy);
+    bool setSpillFile(const string& path, string& errorMsg);
+    CompletedRetention getRetention() const { return retention; }
+    size_t getRetiredCount() const { return retiredCount; }
+
+    // Change the priority boost interval; takes effect from the next tick
+    void setBoostInterval(SimTime interval);
+    SimTime getBoostInterval() const { return boostInterval; }
+
 
 };
 
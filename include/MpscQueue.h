@@ -0,0 +1,82 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+using namespace std;
+
+/**
+ * Unbounded lock-free multi-producer single-consumer queue (an intrusive
+ * linked list in the style of Vyukov's MPSC queue). push() may be called
+ * from any number of threads at once and is one atomic exchange plus a
+ * store, so a producer never waits for the consumer or for other producers
+ * (only for the allocator). drain() and hasPending() belong to a single
+ * consumer thread.
+ *
+ * A producer that has swapped itself in but not yet linked its node hides
+ * the items behind it for that moment; drain() stops there and the next
+ * drain() picks them up. Items from one producer come out in push order.
+ */
+template <class T>
+class MpscQueue
+{
+private:
+    struct Node
+    {
+        atomic<Node*> next;
+        T value;
+    };
+
+    atomic<Node*> head;   // Most recently pushed node
+    Node* tail;           // Consumer side: the node before the next item (a stub at first)
+
+public:
+    MpscQueue() : tail(new Node())
+    {
+        tail->next.store(nullptr, memory_order_relaxed);
+        head.store(tail, memory_order_relaxed);
+    }
+
+    // No producer may still be pushing
+    ~MpscQueue()
+    {
+        while (tail)
+        {
+            Node* next = tail->next.load(memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(const T& value)
+    {
+        Node* node = new Node();
+        node->value = value;
+        node->next.store(nullptr, memory_order_relaxed);
+        Node* prev = head.exchange(node, memory_order_acq_rel);
+        prev->next.store(node, memory_order_release);
+    }
+
+    // One load; true when drain() would find something
+    bool hasPending() const { return tail->next.load(memory_order_acquire) != nullptr; }
+
+    // Pass every item linked so far to consume, oldest first; returns the count
+    template <class Consume>
+    size_t drain(Consume consume)
+    {
+        size_t count = 0;
+        for (Node* next = tail->next.load(memory_order_acquire); next; next = tail->next.load(memory_order_acquire))
+        {
+            consume(next->value);
+            delete tail;
+            tail = next;   // The consumed node becomes the new stub
+            count++;
+        }
+        return count;
+    }
+};
+
+#endif // MPSC_QUEUE_H
@@ -0,0 +1,125 @@
+#ifndef MULTICORE_SCHEDULER_H
+#define MULTICORE_SCHEDULER_H
+
+#include "MLFQScheduler.h"
+#include "ProcessTable.h"
+#include "Queue.h"
+#include "SchedulerConfig.h"
+#include <vector>
+using namespace std;
+
+// Running totals for one simulated CPU
+struct CoreStats
+{
+    long long busyTime;         // Time units spent executing processes
+    long long migrationTime;    // Time units stalled paying migration penalties
+    long long dispatches;       // Processes started or resumed on this core
+    long long steals;           // Processes taken from a peer's ready queues
+    long long migrations;       // Dispatches of a process that last ran elsewhere
+};
+
+/**
+ * MLFQ on several simulated CPUs sharing one process table.
+ *
+ * Every core has its own ready queues and runs one process at a time. New
+ * arrivals go to the least-loaded core. Each tick every core dispatches from
+ * its own queues first; a core still idle then steals the next process of
+ * the running peer with the most ready processes. A process
+ * dispatched on a different core than it last ran on stalls that core for
+ * SchedulerConfig::migrationPenalty before it executes. The boost timer is
+ * global and boosts every core at once.
+ *
+ * With one core and no penalty the schedule matches MLFQScheduler::step().
+ */
+class MultiCoreScheduler
+{
+private:
+    struct Core
+    {
+        MultilevelQueue readyQueues;    // Slots into table
+        ProcessSlot currentSlot;        // NO_PROCESS when idle
+        size_t readyCount;              // Processes waiting in readyQueues
+        SimTime stallLeft;              // Migration penalty left before currentSlot runs
+        CoreStats stats;
+    };
+
+    ProcessTable table;
+    vector<Core> cores;
+    vector<int> lastCore;               // Per slot: core it last ran on (-1 = never)
+    vector<ProcessSlot> completedSlots;
+
+    // Arrival-ordered slots; entries before the cursor have been admitted
+    vector<ProcessSlot> arrivalOrder;
+    size_t arrivalCursor;
+
+    SimTime currentTime;
+    SimTime boostTimer;
+    SimTime boostInterval;
+    int numQueues;
+    int numCores;
+    SimTime migrationPenalty;
+    int pidCounter;
+    SchedulerConfig config;
+    LastQueueAlgorithm lastQueueAlgorithm;
+
+    long long totalWaitTime;
+    long long totalTurnaroundTime;
+    long long totalResponseTime;
+    long long busyTime;
+
+    // Helper methods
+    void indexArrival(ProcessSlot slot);
+    void checkNewArrivals();
+    void makeReady(int core, int level, ProcessSlot slot);
+    int leastLoadedCore() const;
+    int busiestPeer(int core) const;    // -1 when no running peer has a process queued
+    ProcessSlot steal(int core);
+    bool dispatchIfIdle(int core, bool maySteal);
+    void boostAllCores();
+    void finishTick(int core, bool boosted);
+
+public:
+    explicit MultiCoreScheduler(const SchedulerConfig& cfg);
+
+    // Queues point into this scheduler's table
+    MultiCoreScheduler(const MultiCoreScheduler&) = delete;
+    MultiCoreScheduler& operator=(const MultiCoreScheduler&) = delete;
+
+    // Algorithm selection (applies to the last queue of every core)
+    void setLastQueueAlgorithm(LastQueueAlgorithm algorithm);
+    LastQueueAlgorithm getLastQueueAlgorithm() const { return lastQueueAlgorithm; }
+
+    // Process management
+    void addProcess(SimTime arrivalTime, SimTime burstTime);
+    void reserve(size_t processes);
+
+    // Scheduling
+    void step();    // Advance every core by one time unit
+    bool isComplete() const;
+
+    // Getters
+    SimTime getCurrentTime() const { return currentTime; }
+    int getNumCores() const { return numCores; }
+    ProcessView getCurrentProcess(int core) const;
+    const vector<ProcessQueue>& getQueues(int core) const { return cores[core].readyQueues.getLevels(); }
+    ProcessRange<SlotCounter> getAllProcesses() const
+    {
+        return ProcessRange<SlotCounter>(&table, SlotCounter(0), SlotCounter(static_cast<ProcessSlot>(table.size())), table.size());
+    }
+    ProcessRange<vector<ProcessSlot>::const_iterator> getCompletedProcesses() const
+    {
+        return ProcessRange<vector<ProcessSlot>::const_iterator>(&table, completedSlots.begin(), completedSlots.end(), completedSlots.size());
+    }
+    const SchedulerConfig& getConfig() const { return config; }
+
+    // Statistics; cpuUtilization is averaged over all cores
+    SchedulerStats getStats() const;
+    const CoreStats& getCoreStats(int core) const { return cores[core].stats; }
+    double getCoreUtilization(int core) const;
+    SimTime getTurnaroundPercentile(double percentile) const;  // Nearest rank, 0 when nothing completed
+
+    // Reset
+    void reset();
+};
+
+#endif // MULTICORE_SCHEDULER_H
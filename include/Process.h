@@ -1,6 +1,7 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include "SimTime.h"
 #include <string>
 using namespace std;
 
@@ -17,51 +18,56 @@ class Process
 {
 private:
     int pid;
-    int priority;           // queue level (0 = highest)
-    int arrivalTime;
-    int burstTime;
-    int remainingTime;
-    int cpuTimeUsed;
-    int lastRunTime;
-    int queueEnterTime;     // when process entered current queue
-    int waitTime;
-    int turnaroundTime;
-    int responseTime;
-    int completionTime;
+    int priority;               // queue level (0 = highest)
+    SimTime arrivalTime;
+    SimTime burstTime;
+    SimTime remainingTime;
+    SimTime cpuTimeUsed;
+    SimTime lastRunTime;
+    SimTime queueEnterTime;     // when process entered current queue
+    SimTime readySince;         // when process last became READY (wait not yet folded in)
+    SimTime waitTime;
+    SimTime turnaroundTime;
+    SimTime responseTime;
+    SimTime completionTime;
     bool firstRun;
     ProcessState state;
 
 public:
     // Constructor
-    Process(int id, int arrival, int burst);
+    Process(int id, SimTime arrival, SimTime burst);
     
     // Getters
     int getPid() const { return pid; }
     int getPriority() const { return priority; }
-    int getArrivalTime() const { return arrivalTime; }
-    int getBurstTime() const { return burstTime; }
-    int getRemainingTime() const { return remainingTime; }
-    int getCpuTimeUsed() const { return cpuTimeUsed; }
-    int getLastRunTime() const { return lastRunTime; }
-    int getQueueEnterTime() const { return queueEnterTime; }
-    int getWaitTime() const { return waitTime; }
-    int getTurnaroundTime() const { return turnaroundTime; }
-    int getResponseTime() const { return responseTime; }
-    int getCompletionTime() const { return completionTime; }
+    SimTime getArrivalTime() const { return arrivalTime; }
+    SimTime getBurstTime() const { return burstTime; }
+    SimTime getRemainingTime() const { return remainingTime; }
+    SimTime getCpuTimeUsed() const { return cpuTimeUsed; }
+    SimTime getLastRunTime() const { return lastRunTime; }
+    SimTime getQueueEnterTime() const { return queueEnterTime; }
+    SimTime getReadySince() const { return readySince; }
+    SimTime getWaitTime() const { return waitTime; }
+    SimTime getWaitTimeAt(SimTime currentTime) const;  // Includes wait not yet folded in
+    SimTime getTurnaroundTime() const { return turnaroundTime; }
+    SimTime getResponseTime() const { return responseTime; }
+    SimTime getCompletionTime() const { return completionTime; }
     ProcessState getState() const { return state; }
     bool isFirstRun() const { return firstRun; }
     
     // Setters
     void setPriority(int p) { priority = p; }
     void setState(ProcessState s) { state = s; }
-    void setLastRunTime(int t) { lastRunTime = t; }
-    void setQueueEnterTime(int t) { queueEnterTime = t; }
-    void setCompletionTime(int t) { completionTime = t; }
+    void setLastRunTime(SimTime t) { lastRunTime = t; }
+    void setQueueEnterTime(SimTime t) { queueEnterTime = t; }
+    void setCompletionTime(SimTime t) { completionTime = t; }
     
     // Operations
-    void execute(int timeSlice, int currentTime);
+    void execute(SimTime timeSlice, SimTime currentTime);
     void incrementWaitTime() { waitTime++; }
-    void calculateMetrics(int currentTime);
+    void markReady(SimTime currentTime);       // Enter READY and start the wait clock
+    void accrueWaitTime(SimTime currentTime);  // Fold elapsed READY time into waitTime
+    void calculateMetrics(SimTime currentTime);
     void resetToHighestPriority();
     void reset();  // Reset process to initial state
     
@@ -0,0 +1,427 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include "Process.h"
+#include "SimTime.h"
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Index of a process inside a ProcessTable
+typedef uint32_t ProcessSlot;
+const ProcessSlot NO_PROCESS = UINT32_MAX;
+
+class ProcessTable;
+
+// Integer columns ProcessTable can reduce in bulk (sumColumn, argMinColumn, argMaxColumn)
+enum class ProcessColumn
+{
+    REMAINING_TIME,
+    WAIT_TIME,
+    RESPONSE_TIME,
+    COMPLETION_TIME,
+    TURNAROUND_TIME
+};
+
+/**
+ * Read-only view of one process in a ProcessTable. Offers the same getters
+ * as Process, so display code can use views where it used Process pointers.
+ */
+class ProcessView
+{
+private:
+    const ProcessTable* table;
+    ProcessSlot slot;
+
+public:
+    ProcessView() : table(nullptr), slot(NO_PROCESS) {}
+    ProcessView(const ProcessTable* t, ProcessSlot s) : table(t), slot(s) {}
+
+    // Pointer-like use: view->getPid(), if (view)
+    const ProcessView* operator->() const { return this; }
+    explicit operator bool() const { return table != nullptr && slot != NO_PROCESS; }
+    bool operator==(const ProcessView& other) const { return table == other.table && slot == other.slot; }
+    bool operator!=(const ProcessView& other) const { return !(*this == other); }
+
+    ProcessSlot getSlot() const { return slot; }
+
+    int getPid() const;
+    int getPriority() const;
+    SimTime getArrivalTime() const;
+    SimTime getBurstTime() const;
+    SimTime getRemainingTime() const;
+    SimTime getCpuTimeUsed() const;
+    SimTime getLastRunTime() const;
+    SimTime getQueueEnterTime() const;
+    SimTime getReadySince() const;
+    SimTime getWaitTime() const;
+    SimTime getWaitTimeAt(SimTime currentTime) const;
+    SimTime getTurnaroundTime() const;
+    SimTime getResponseTime() const;
+    SimTime getCompletionTime() const;
+    ProcessState getState() const;
+    bool isFirstRun() const;
+
+    string toString() const;
+};
+
+/**
+ * Final figures of one completed process. Unlike a ProcessView it owns its
+ * values, so it outlives the process's table slot: retired processes are
+ * read back as CompletedProcess records (see CompletionLog). The getters
+ * match Process, so report code treats both kinds of entry alike.
+ */
+struct CompletedProcess
+{
+    int pid;
+    SimTime arrivalTime;
+    SimTime burstTime;
+    SimTime completionTime;
+    SimTime turnaroundTime;
+    SimTime waitTime;
+    SimTime responseTime;
+
+    const CompletedProcess* operator->() const { return this; }
+
+    int getPid() const { return pid; }
+    SimTime getArrivalTime() const { return arrivalTime; }
+    SimTime getBurstTime() const { return burstTime; }
+    SimTime getRemainingTime() const { return 0; }
+    SimTime getCpuTimeUsed() const { return burstTime; }
+    SimTime getCompletionTime() const { return completionTime; }
+    SimTime getTurnaroundTime() const { return turnaroundTime; }
+    SimTime getWaitTime() const { return waitTime; }
+    SimTime getResponseTime() const { return responseTime; }
+    ProcessState getState() const { return ProcessState::TERMINATED; }
+};
+
+/**
+ * Engine-side process storage. Each field is a separate array indexed by
+ * ProcessSlot, so the scheduler's per-tick loops walk dense arrays instead
+ * of chasing one heap object per process.
+ *
+ * Fields are grouped by how often they are touched. Hot columns (priority,
+ * state, remaining time, queue timestamps and links) are read and written
+ * on every dispatch and slice; static columns (pid, arrival, burst) are
+ * written once by add(); report columns (completion and turnaround time)
+ * are written once on completion and their chunk is only allocated when
+ * the first process in it completes. cpuTimeUsed is derived from burst and
+ * remaining time.
+ *
+ * The arrays are carved from fixed-size chunks that are allocated once and
+ * never move: adding a process writes into the current chunk, and clear()
+ * only rewinds the fill count, so a reset keeps the memory for the next
+ * workload and releases the old one in O(1).
+ *
+ * A completed process can be retired, which drops it from the live slots.
+ * Slots are not reused, but once every slot of a filled chunk is retired the
+ * chunk's storage is freed, so a long run holds memory for the chunks that
+ * still contain a live process plus one null pointer per 1024 retired ones.
+ *
+ * Copies share chunks: copying a table costs one pointer per chunk, and
+ * the first write to a shared chunk clones just that chunk.
+ */
+class ProcessTable
+{
+public:
+    static const size_t CHUNK_SHIFT = 10;
+    static const size_t CHUNK_SIZE = size_t(1) << CHUNK_SHIFT;  // Processes per chunk
+
+private:
+    struct HotChunk
+    {
+        int priority[CHUNK_SIZE];           // queue level (0 = highest)
+        uint32_t priorityEpoch[CHUNK_SIZE]; // boost epoch in which priority was set
+        ProcessState state[CHUNK_SIZE];
+        SimTime remainingTime[CHUNK_SIZE];
+        SimTime queueEnterTime[CHUNK_SIZE]; // when process entered current queue
+        SimTime readySince[CHUNK_SIZE];     // when process last became READY
+        SimTime waitTime[CHUNK_SIZE];
+        SimTime responseTime[CHUNK_SIZE];   // -1 until first run
+        SimTime lastRunTime[CHUNK_SIZE];
+        int queueSlot[CHUNK_SIZE];          // position inside an ordered ProcessQueue's heap
+        long long queueSeq[CHUNK_SIZE];     // enqueue order, breaks ties between equal keys
+        ProcessSlot queuePrev[CHUNK_SIZE];  // FIFO ready-list links; both point at the
+        ProcessSlot queueNext[CHUNK_SIZE];  // process itself while it is not linked
+    };
+
+    struct StaticChunk
+    {
+        int pid[CHUNK_SIZE];
+        SimTime arrivalTime[CHUNK_SIZE];
+        SimTime burstTime[CHUNK_SIZE];
+        bool retired[CHUNK_SIZE];           // Set once by retire()
+    };
+
+    struct ReportChunk
+    {
+        SimTime completionTime[CHUNK_SIZE];
+        SimTime turnaroundTime[CHUNK_SIZE];
+    };
+
+    // Allocated chunks, kept across clear(); reports[i] stays null until a
+    // process in chunk i completes
+    vector<shared_ptr<HotChunk>> hot;
+    vector<shared_ptr<StaticChunk>> statics;
+    vector<shared_ptr<ReportChunk>> reports;
+    vector<uint16_t> resident;              // Per chunk: slots added and not retired
+    size_t count;                           // Slots in use
+    size_t retiredCount;                    // Slots retired, their chunk possibly freed
+    uint32_t boostEpoch;                    // Number of priority boosts so far
+
+    // Writes go through here, so a chunk still shared with a copy is cloned first
+    template <class Chunk>
+    static Chunk& writable(vector<shared_ptr<Chunk>>& chunks, ProcessSlot s)
+    {
+        shared_ptr<Chunk>& c = chunks[s >> CHUNK_SHIFT];
+        if (c.use_count() > 1)
+        {
+            c = make_shared<Chunk>(*c);
+        }
+        return *c;
+    }
+    HotChunk& hotChunk(ProcessSlot s) { return writable(hot, s); }
+    const HotChunk& hotChunk(ProcessSlot s) const { return *hot[s >> CHUNK_SHIFT]; }
+    StaticChunk& staticChunk(ProcessSlot s) { return writable(statics, s); }
+    const StaticChunk& staticChunk(ProcessSlot s) const { return *statics[s >> CHUNK_SHIFT]; }
+    ReportChunk& reportChunk(ProcessSlot s);   // Allocates on first completion
+    const ReportChunk* reportChunk(ProcessSlot s) const { return reports[s >> CHUNK_SHIFT].get(); }
+    static size_t offset(ProcessSlot s) { return s & (CHUNK_SIZE - 1); }
+    const SimTime* columnData(ProcessColumn column, size_t chunk) const;  // nullptr: all zero
+    template <bool Largest>
+    ProcessSlot argColumn(ProcessColumn column, ProcessSlot first, ProcessSlot last) const;
+
+public:
+    ProcessTable() : count(0), retiredCount(0), boostEpoch(0) {}
+    ProcessTable(const ProcessTable& other);             // O(chunks); storage is shared
+    ProcessTable& operator=(const ProcessTable& other);
+
+    ProcessSlot add(int processId, SimTime arrival, SimTime burst);
+    size_t size() const { return count; }            // Slots used, retired ones included
+    size_t liveCount() const { return count - retiredCount; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return hot.size() * CHUNK_SIZE; }
+    void reserve(size_t processes);  // Allocate chunks up front
+    void clear() { count = 0; retiredCount = 0; }  // O(1); chunks are reused by the next add()
+    void release();                  // Clear and free every chunk
+
+    // Drop a completed process; its slot must not be read afterwards.
+    // Frees the slot's chunk once every slot in it is retired
+    void retire(ProcessSlot s);
+    bool isRetired(ProcessSlot s) const
+    {
+        const StaticChunk* c = statics[s >> CHUNK_SHIFT].get();
+        return !c || c->retired[offset(s)];
+    }
+    CompletedProcess completed(ProcessSlot s) const;  // Copy out a completed process's figures
+
+    // Slot of a live process by pid, NO_PROCESS if none. The schedulers
+    // number pids from 1 in add() order, so the table is its own pid index
+    // and this is O(1); tables numbered otherwise always miss
+    ProcessSlot findPid(int pid) const
+    {
+        if (pid < 1 || static_cast<size_t>(pid) > count)
+        {
+            return NO_PROCESS;
+        }
+        ProcessSlot s = static_cast<ProcessSlot>(pid - 1);
+        return (!isRetired(s) && getPid(s) == pid) ? s : NO_PROCESS;
+    }
+
+    ProcessView view(ProcessSlot slot) const { return ProcessView(this, slot); }
+
+    // Getters
+    int getPid(ProcessSlot s) const { return staticChunk(s).pid[offset(s)]; }
+    int getPriority(ProcessSlot s) const
+    {
+        // A READY process whose priority predates the last boost is at level 0
+        const HotChunk& c = hotChunk(s);
+        size_t i = offset(s);
+        return (c.state[i] == ProcessState::READY && c.priorityEpoch[i] != boostEpoch) ? 0 : c.priority[i];
+    }
+    SimTime getArrivalTime(ProcessSlot s) const { return staticChunk(s).arrivalTime[offset(s)]; }
+    SimTime getBurstTime(ProcessSlot s) const { return staticChunk(s).burstTime[offset(s)]; }
+    SimTime getRemainingTime(ProcessSlot s) const { return hotChunk(s).remainingTime[offset(s)]; }
+    SimTime getCpuTimeUsed(ProcessSlot s) const { return getBurstTime(s) - getRemainingTime(s); }
+    SimTime getLastRunTime(ProcessSlot s) const { return hotChunk(s).lastRunTime[offset(s)]; }
+    SimTime getQueueEnterTime(ProcessSlot s) const { return hotChunk(s).queueEnterTime[offset(s)]; }
+    SimTime getReadySince(ProcessSlot s) const { return hotChunk(s).readySince[offset(s)]; }
+    SimTime getWaitTime(ProcessSlot s) const { return hotChunk(s).waitTime[offset(s)]; }
+    SimTime getTurnaroundTime(ProcessSlot s) const
+    {
+        const ReportChunk* r = reportChunk(s);
+        return r ? r->turnaroundTime[offset(s)] : 0;
+    }
+    SimTime getResponseTime(ProcessSlot s) const { return hotChunk(s).responseTime[offset(s)]; }
+    SimTime getCompletionTime(ProcessSlot s) const
+    {
+        const ReportChunk* r = reportChunk(s);
+        return r ? r->completionTime[offset(s)] : 0;
+    }
+    ProcessState getState(ProcessSlot s) const { return hotChunk(s).state[offset(s)]; }
+    bool isFirstRun(ProcessSlot s) const { return hotChunk(s).responseTime[offset(s)] < 0; }
+    int getQueueSlot(ProcessSlot s) const { return hotChunk(s).queueSlot[offset(s)]; }
+    long long getQueueSeq(ProcessSlot s) const { return hotChunk(s).queueSeq[offset(s)]; }
+    ProcessSlot getQueuePrev(ProcessSlot s) const { return hotChunk(s).queuePrev[offset(s)]; }
+    ProcessSlot getQueueNext(ProcessSlot s) const { return hotChunk(s).queueNext[offset(s)]; }
+    bool isLinked(ProcessSlot s) const { return hotChunk(s).queueNext[offset(s)] != s; }
+    SimTime getWaitTimeAt(ProcessSlot s, SimTime currentTime) const;
+
+    // Reductions over slots [first, last), one SimdKernels call per chunk.
+    // The arg versions return the first matching slot, NO_PROCESS if empty
+    long long sumColumn(ProcessColumn column, ProcessSlot first, ProcessSlot last) const;
+    ProcessSlot argMinColumn(ProcessColumn column, ProcessSlot first, ProcessSlot last) const;
+    ProcessSlot argMaxColumn(ProcessColumn column, ProcessSlot first, ProcessSlot last) const;
+
+    // Setters
+    void setPriority(ProcessSlot s, int p)
+    {
+        HotChunk& c = hotChunk(s);
+        c.priority[offset(s)] = p;
+        c.priorityEpoch[offset(s)] = boostEpoch;
+    }
+    void setState(ProcessSlot s, ProcessState st) { hotChunk(s).state[offset(s)] = st; }
+    void setLastRunTime(ProcessSlot s, SimTime t) { hotChunk(s).lastRunTime[offset(s)] = t; }
+    void setQueueEnterTime(ProcessSlot s, SimTime t) { hotChunk(s).queueEnterTime[offset(s)] = t; }
+    void setCompletionTime(ProcessSlot s, SimTime t) { reportChunk(s).completionTime[offset(s)] = t; }
+    void setQueueSlot(ProcessSlot s, int slot) { hotChunk(s).queueSlot[offset(s)] = slot; }
+    void setQueueSeq(ProcessSlot s, long long seq) { hotChunk(s).queueSeq[offset(s)] = seq; }
+    void setQueuePrev(ProcessSlot s, ProcessSlot prev) { hotChunk(s).queuePrev[offset(s)] = prev; }
+    void setQueueNext(ProcessSlot s, ProcessSlot next) { hotChunk(s).queueNext[offset(s)] = next; }
+    void unlink(ProcessSlot s)
+    {
+        HotChunk& c = hotChunk(s);
+        c.queuePrev[offset(s)] = s;
+        c.queueNext[offset(s)] = s;
+    }
+
+    // Operations (same semantics as the Process methods of the same name)
+    void execute(ProcessSlot s, SimTime timeSlice, SimTime currentTime);
+    void markReady(ProcessSlot s, SimTime currentTime);
+    void accrueWaitTime(ProcessSlot s, SimTime currentTime);
+    void calculateMetrics(ProcessSlot s, SimTime currentTime);
+    void resetToHighestPriority(ProcessSlot s) { setPriority(s, 0); }
+    void setBurst(ProcessSlot s, SimTime burst);  // Keeps the CPU time already used
+
+    // Priority boost: every READY process now reads as priority 0, in O(1)
+    void advanceBoostEpoch() { boostEpoch++; }
+    uint32_t getBoostEpoch() const { return boostEpoch; }
+
+    string toString(ProcessSlot s) const;
+};
+
+/**
+ * Iterable sequence of processes backed by a sequence of slots, yielding
+ * ProcessViews. Supports size(), indexing and back() when the underlying
+ * slot iterator does.
+ */
+template <class SlotIterator>
+class ProcessRange
+{
+private:
+    const ProcessTable* table;
+    SlotIterator first;
+    SlotIterator last;
+    size_t count;
+
+public:
+    class iterator
+    {
+    private:
+        const ProcessTable* table;
+        SlotIterator it;
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef ProcessView value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const ProcessView* pointer;
+        typedef ProcessView reference;
+
+        iterator(const ProcessTable* t, SlotIterator i) : table(t), it(i) {}
+        ProcessView operator*() const { return table->view(*it); }
+        iterator& operator++() { ++it; return *this; }
+        bool operator==(const iterator& other) const { return it == other.it; }
+        bool operator!=(const iterator& other) const { return it != other.it; }
+    };
+
+    ProcessRange(const ProcessTable* t, SlotIterator f, SlotIterator l, size_t n)
+        : table(t), first(f), last(l), count(n) {}
+
+    iterator begin() const { return iterator(table, first); }
+    iterator end() const { return iterator(table, last); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    ProcessView operator[](size_t index) const { return table->view(*next(first, index)); }
+    ProcessView front() const { return table->view(*first); }
+    ProcessView back() const { return table->view(*prev(last)); }
+};
+
+/**
+ * Iterator over consecutive slots, used to walk a whole ProcessTable
+ */
+class SlotCounter
+{
+private:
+    ProcessSlot slot;
+
+public:
+    typedef random_access_iterator_tag iterator_category;
+    typedef ProcessSlot value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const ProcessSlot* pointer;
+    typedef ProcessSlot reference;
+
+    explicit SlotCounter(ProcessSlot s = 0) : slot(s) {}
+    ProcessSlot operator*() const { return slot; }
+    SlotCounter& operator++() { ++slot; return *this; }
+    SlotCounter& operator--() { --slot; return *this; }
+    SlotCounter& operator+=(ptrdiff_t n) { slot += static_cast<ProcessSlot>(n); return *this; }
+    SlotCounter& operator-=(ptrdiff_t n) { slot -= static_cast<ProcessSlot>(n); return *this; }
+    SlotCounter operator+(ptrdiff_t n) const { return SlotCounter(slot + static_cast<ProcessSlot>(n)); }
+    SlotCounter operator-(ptrdiff_t n) const { return SlotCounter(slot - static_cast<ProcessSlot>(n)); }
+    ptrdiff_t operator-(const SlotCounter& other) const { return static_cast<ptrdiff_t>(slot) - other.slot; }
+    ProcessSlot operator[](ptrdiff_t n) const { return slot + static_cast<ProcessSlot>(n); }
+    bool operator==(const SlotCounter& other) const { return slot == other.slot; }
+    bool operator!=(const SlotCounter& other) const { return slot != other.slot; }
+    bool operator<(const SlotCounter& other) const { return slot < other.slot; }
+};
+
+/**
+ * Iterator over the slots of a ProcessTable that have not been retired
+ */
+class LiveSlotCounter
+{
+private:
+    const ProcessTable* table;
+    ProcessSlot slot;
+
+    void skipForward()
+    {
+        while (slot < table->size() && table->isRetired(slot)) ++slot;
+    }
+
+public:
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef ProcessSlot value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const ProcessSlot* pointer;
+    typedef ProcessSlot reference;
+
+    LiveSlotCounter(const ProcessTable* t, ProcessSlot s) : table(t), slot(s) { skipForward(); }
+    ProcessSlot operator*() const { return slot; }
+    LiveSlotCounter& operator++() { ++slot; skipForward(); return *this; }
+    LiveSlotCounter& operator--()
+    {
+        do { --slot; } while (table->isRetired(slot));
+        return *this;
+    }
+    bool operator==(const LiveSlotCounter& other) const { return slot == other.slot; }
+    bool operator!=(const LiveSlotCounter& other) const { return slot != other.slot; }
+};
+
+#endif // PROCESS_TABLE_H
@@ -1,40 +1,412 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
-#include "Process.h"
-#include <deque>
-#include <memory>
+#include "CowVector.h"
+#include "ProcessTable.h"
+#include <vector>
+#include <cstdint>
+#include <iterator>
 using namespace std;
 
-class ProcessQueue 
+/**
+ * Service order of a ProcessQueue. FIFO is plain round-robin; the ordered
+ * modes keep the queue as a binary min-heap addressed through each
+ * process's queue slot, so insert, pop and arbitrary removal are O(log n).
+ */
+enum class QueueOrder
 {
+    FIFO,
+    SHORTEST_REMAINING_FIRST,   // Smallest remaining time, then enqueue order
+    LONGEST_WAIT_FIRST          // Largest wait time, then arrival, then enqueue order
+};
+
+/**
+ * The service orders as types. Code that knows a queue's order at compile
+ * time calls ProcessQueue::push/pop with one of these and gets the heap
+ * comparison inlined; the untyped queue operations switch on the order once
+ * and forward here. before() is the strict service order.
+ */
+struct FifoOrder
+{
+    static constexpr QueueOrder order = QueueOrder::FIFO;
+    static bool before(const ProcessTable& table, ProcessSlot a, ProcessSlot b)
+    {
+        return table.getQueueSeq(a) < table.getQueueSeq(b);
+    }
+};
+
+struct ShortestRemainingOrder
+{
+    static constexpr QueueOrder order = QueueOrder::SHORTEST_REMAINING_FIRST;
+    static bool before(const ProcessTable& table, ProcessSlot a, ProcessSlot b)
+    {
+        SimTime remainingA = table.getRemainingTime(a);
+        SimTime remainingB = table.getRemainingTime(b);
+        if (remainingA != remainingB)
+        {
+            return remainingA < remainingB;
+        }
+        return table.getQueueSeq(a) < table.getQueueSeq(b);
+    }
+};
+
+struct LongestWaitOrder
+{
+    static constexpr QueueOrder order = QueueOrder::LONGEST_WAIT_FIRST;
+    static bool before(const ProcessTable& table, ProcessSlot a, ProcessSlot b)
+    {
+        // Every queued process accrues wait at the same rate, so
+        // waitTime - readySince ranks them the same way at any instant
+        SimTime waitA = table.getWaitTime(a) - table.getReadySince(a);
+        SimTime waitB = table.getWaitTime(b) - table.getReadySince(b);
+        if (waitA != waitB)
+        {
+            return waitA > waitB;
+        }
+        if (table.getArrivalTime(a) != table.getArrivalTime(b))
+        {
+            return table.getArrivalTime(a) < table.getArrivalTime(b);
+        }
+        return table.getQueueSeq(a) < table.getQueueSeq(b);
+    }
+};
+
+/**
+ * One priority level. Holds 32-bit slots into the owner's ProcessTable.
+ *
+ * A FIFO queue is an intrusive doubly-linked list threaded through the
+ * table's queuePrev/queueNext columns, so removing any process, moving it
+ * to another level and splicing a whole level are O(1). The ordered modes
+ * keep a binary heap instead, in copy-on-write storage so that copying a
+ * queue along with its table is cheap.
+ */
+class ProcessQueue
+{
+public:
+    typedef CowVector<ProcessSlot, 8> HeapStorage;
+
+    /**
+     * Walks the queue's slots: list order for FIFO, heap order otherwise.
+     */
+    class SlotIterator
+    {
+    private:
+        const ProcessTable* table;
+        const HeapStorage* heap;       // Null when following links
+        size_t position;               // Into the heap
+        ProcessSlot link;
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef ProcessSlot value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const ProcessSlot* pointer;
+        typedef ProcessSlot reference;
+
+        SlotIterator(const ProcessTable* t, const HeapStorage* h, size_t p, ProcessSlot l)
+            : table(t), heap(h), position(p), link(l) {}
+        ProcessSlot operator*() const { return heap ? (*heap)[position] : link; }
+        SlotIterator& operator++()
+        {
+            if (heap) ++position;
+            else link = table->getQueueNext(link);
+            return *this;
+        }
+        bool operator==(const SlotIterator& other) const { return position == other.position && link == other.link; }
+        bool operator!=(const SlotIterator& other) const { return !(*this == other); }
+    };
+
+    typedef ProcessRange<SlotIterator> Range;
+
 private:
-    deque<shared_ptr<Process>> queue;
+    ProcessSlot head;                  // FIFO list ends (NO_PROCESS when empty)
+    ProcessSlot tail;
+    HeapStorage heap;                  // Ordered modes only
+    size_t count;
     int queueLevel;
-    int timeQuantum;
+    SimTime timeQuantum;
+    QueueOrder order;
+    long long enqueueCounter;          // Tie-breaker for equal keys
+    ProcessTable* table;               // Owner's process storage
+    uint64_t* readyMask;               // Owner's non-empty bitmap (may be null)
+
+    inline void updateReadyBit();
+    inline void linkBack(ProcessSlot slot);
+    inline void unlink(ProcessSlot slot);
+    // Heap helpers (ordered modes only)
+    bool before(ProcessSlot a, ProcessSlot b) const;        // Service order
+    bool listedBefore(ProcessSlot a, ProcessSlot b) const;  // Queue (list) order
+    void place(size_t position, ProcessSlot slot)
+    {
+        table->setQueueSlot(slot, static_cast<int>(position));
+        heap.at(position) = slot;
+    }
+    template <class Policy> void siftUp(size_t position);
+    template <class Policy> void siftDown(size_t position);
+    template <class Policy> ProcessSlot removeAt(size_t position);
+    ProcessSlot removeAt(size_t position);
 
 public:
-    ProcessQueue(int level, int quantum);
-    
+    ProcessQueue(int level, SimTime quantum, QueueOrder order = QueueOrder::FIFO);
+
+    // Attach to the owner's process storage and non-empty bitmap
+    void bindTable(ProcessTable* processTable) { table = processTable; }
+    void bindReadyMask(uint64_t* mask);
+
     // Queue operations
-    void enqueue(shared_ptr<Process> process);
-    shared_ptr<Process> dequeue();
-    shared_ptr<Process> peek() const;
-    
+    void enqueue(ProcessSlot slot);
+    ProcessSlot dequeue();             // NO_PROCESS when empty
+    ProcessSlot peek() const;          // NO_PROCESS when empty
+
+    // enqueue/dequeue for callers that know the order statically;
+    // Policy::order must equal getOrder()
+    template <class Policy> void push(ProcessSlot slot);
+    template <class Policy> ProcessSlot pop();
+
     // Getters
-    bool isEmpty() const { return queue.empty(); }
-    size_t size() const { return queue.size(); }
+    bool isEmpty() const { return count == 0; }
+    size_t size() const { return count; }
     int getQueueLevel() const { return queueLevel; }
-    int getTimeQuantum() const { return timeQuantum; }
-    
-    // Get all processes (for visualization)
-    const deque<shared_ptr<Process>>& getProcesses() const { return queue; }
-    
-    // Remove specific process
+    SimTime getTimeQuantum() const { return timeQuantum; }
+    QueueOrder getOrder() const { return order; }
+
+    // Change the service order, re-keying the processes already queued
+    void setOrder(QueueOrder newOrder);
+
+    // Remove every process, returned in queue order: FIFO order, shortest
+    // remaining time first, or oldest arrival first for LONGEST_WAIT_FIRST
+    vector<ProcessSlot> drain();
+
+    // Append every process of other to this queue, keeping their order.
+    // O(1) between FIFO queues. Spliced processes keep their stored
+    // priority until they leave this queue, which settles it to this level
+    void splice(ProcessQueue& other);
+
+    // Get all processes (for visualization); heap order in the ordered modes
+    Range getProcesses() const;
+
+    // Remove specific process. removeSlot is O(1) for FIFO queues and
+    // O(log n) otherwise; the slot must be queued here or not at all.
+    // removeProcess finds the slot through ProcessTable::findPid and only
+    // scans the queue when that misses
     bool removeProcess(int pid);
-    
-    // Clear queue
-    void clear() { queue.clear(); }
+    bool removeSlot(ProcessSlot slot);
+
+    // Restore the service order after a queued process's key (remaining
+    // time or wait) changed in the table. O(log n); nothing to do for FIFO
+    void rekey(ProcessSlot slot);
+
+    // Forget every process in O(1); their link fields are left stale
+    void clear();
+
+    // Preallocate heap storage; FIFO queues need none
+    void reserve(size_t processes)
+    {
+        if (order != QueueOrder::FIFO)
+        {
+            heap.reserve(processes);
+        }
+    }
 };
 
+/**
+ * The ready queues of every priority level. Each level keeps its bit in
+ * nonEmptyMask current on enqueue and dequeue, so the highest-priority
+ * ready level is found with a single find-first-set.
+ */
+class MultilevelQueue
+{
+private:
+    vector<ProcessQueue> levels;
+    uint64_t nonEmptyMask;
+
+    void bindLevels();
+
+public:
+    static constexpr int MAX_LEVELS = 64;
+
+    MultilevelQueue();
+    explicit MultilevelQueue(const vector<SimTime>& quantums);
+    MultilevelQueue(const MultilevelQueue& other);
+    MultilevelQueue& operator=(const MultilevelQueue& other);
+
+    // Attach every level to the owner's process storage
+    void bindTable(ProcessTable* table);
+
+    ProcessQueue& operator[](size_t level) { return levels[level]; }
+    const ProcessQueue& operator[](size_t level) const { return levels[level]; }
+    ProcessQueue& back() { return levels.back(); }
+    // Move a queued process to another level (O(1) between FIFO levels)
+    bool moveProcess(ProcessSlot slot, int fromLevel, int toLevel);
+    size_t size() const { return levels.size(); }
+    vector<ProcessQueue>::iterator begin() { return levels.begin(); }
+    vector<ProcessQueue>::iterator end() { return levels.end(); }
+
+    bool isEmpty() const { return nonEmptyMask == 0; }
+    uint64_t getReadyMask() const { return nonEmptyMask; }
+    int highestReadyLevel() const;  // -1 when every level is empty
+
+    const vector<ProcessQueue>& getLevels() const { return levels; }
+};
+
+inline void ProcessQueue::updateReadyBit()
+{
+    if (!readyMask || queueLevel < 0 || queueLevel >= MultilevelQueue::MAX_LEVELS)
+    {
+        return;
+    }
+
+    uint64_t bit = uint64_t(1) << queueLevel;
+    if (count == 0)
+    {
+        *readyMask &= ~bit;
+    }
+    else
+    {
+        *readyMask |= bit;
+    }
+}
+
+inline void ProcessQueue::linkBack(ProcessSlot slot)
+{
+    table->setQueuePrev(slot, tail);
+    table->setQueueNext(slot, NO_PROCESS);
+    if (tail == NO_PROCESS)
+    {
+        head = slot;
+    }
+    else
+    {
+        table->setQueueNext(tail, slot);
+    }
+    tail = slot;
+}
+
+inline void ProcessQueue::unlink(ProcessSlot slot)
+{
+    ProcessSlot prev = table->getQueuePrev(slot);
+    ProcessSlot next = table->getQueueNext(slot);
+    if (prev == NO_PROCESS)
+    {
+        head = next;
+    }
+    else
+    {
+        table->setQueueNext(prev, next);
+    }
+    if (next == NO_PROCESS)
+    {
+        tail = prev;
+    }
+    else
+    {
+        table->setQueuePrev(next, prev);
+    }
+    table->unlink(slot);
+}
+
+template <class Policy>
+void ProcessQueue::siftUp(size_t position)
+{
+    ProcessSlot slot = heap[position];
+    while (position > 0)
+    {
+        size_t parent = (position - 1) / 2;
+        if (!Policy::before(*table, slot, heap[parent]))
+        {
+            break;
+        }
+        place(position, heap[parent]);
+        position = parent;
+    }
+    place(position, slot);
+}
+
+template <class Policy>
+void ProcessQueue::siftDown(size_t position)
+{
+    ProcessSlot slot = heap[position];
+    size_t size = heap.size();
+    while (true)
+    {
+        size_t child = 2 * position + 1;
+        if (child >= size)
+        {
+            break;
+        }
+        if (child + 1 < size && Policy::before(*table, heap[child + 1], heap[child]))
+        {
+            child++;
+        }
+        if (!Policy::before(*table, heap[child], slot))
+        {
+            break;
+        }
+        place(position, heap[child]);
+        position = child;
+    }
+    place(position, slot);
+}
+
+template <class Policy>
+ProcessSlot ProcessQueue::removeAt(size_t position)
+{
+    ProcessSlot slot = heap[position];
+    ProcessSlot last = heap.back();
+    heap.pop_back();
+
+    if (position < heap.size())
+    {
+        place(position, last);
+        siftDown<Policy>(position);
+        siftUp<Policy>(table->getQueueSlot(last));
+    }
+    table->setQueueSlot(slot, -1);
+    return slot;
+}
+
+template <class Policy>
+void ProcessQueue::push(ProcessSlot slot)
+{
+    table->setPriority(slot, queueLevel);
+    table->setState(slot, ProcessState::READY);
+    table->setQueueSeq(slot, enqueueCounter++);
+
+    if (Policy::order != QueueOrder::FIFO)
+    {
+        heap.push_back(slot);
+        siftUp<Policy>(heap.size() - 1);
+    }
+    else
+    {
+        linkBack(slot);
+    }
+    count++;
+    updateReadyBit();
+}
+
+template <class Policy>
+ProcessSlot ProcessQueue::pop()
+{
+    if (count == 0)
+    {
+        return NO_PROCESS;
+    }
+
+    ProcessSlot slot;
+    if (Policy::order != QueueOrder::FIFO)
+    {
+        slot = removeAt<Policy>(0);
+    }
+    else
+    {
+        slot = head;
+        unlink(slot);
+    }
+    count--;
+    updateReadyBit();
+    table->setPriority(slot, queueLevel);  // Settle a priority left stale by splice
+    return slot;
+}
+
 #endif // QUEUE_H
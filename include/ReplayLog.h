@@ -0,0 +1,100 @@
+#ifndef REPLAY_LOG_H
+#define REPLAY_LOG_H
+
+#include "MLFQScheduler.h"
+#include "SchedulerConfig.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+// One recorded scheduler input, stamped with the clock when it was applied
+struct ReplayEvent
+{
+    enum Type : uint8_t
+    {
+        ADD_PROCESS = 1,        // a = arrival time, b = burst time
+        SET_ALGORITHM = 2,      // a = LastQueueAlgorithm
+        SET_BOOST_INTERVAL = 3, // a = interval
+        END = 4,                // Recording finished; hash of the execution log
+        CANCEL_PROCESS = 5,     // a = pid
+        SET_BURST = 6           // a = pid, b = burst time
+    };
+
+    Type type;
+    SimTime time;
+    SimTime a;
+    SimTime b;
+};
+
+// Outcome of ReplayLog::replay()
+struct ReplayResult
+{
+    uint64_t hash;      // Hash of the replayed execution log
+    SimTime endTime;    // Clock when the replay stopped
+    bool matches;       // hash equals the recorded hash
+};
+
+/**
+ * Every input a MLFQScheduler received during one run: its configuration,
+ * process submissions, cancellations and burst changes, algorithm switches
+ * and boost interval changes, each
+ * stamped with the scheduler clock. A scheduler records into an attached log
+ * (MLFQScheduler::setRecorder); replay() feeds the inputs to a fresh
+ * scheduler at full speed and checks the execution log hash matches.
+ * The check needs the whole execution log, so finish() refuses a run that
+ * did bulk work with logging off or was rewound by restore().
+ *
+ * On disk the log is a magic tag, the configuration, and one record per
+ * event: a type byte, the time delta as a varint and zigzag varint
+ * arguments. Adding a process in arrival order costs about four bytes.
+ */
+class ReplayLog
+{
+private:
+    SchedulerConfig config;
+    LastQueueAlgorithm initialAlgorithm;
+    vector<ReplayEvent> events;
+    bool finished;
+    bool logComplete;   // Every span of the recorded run reached its execution log
+    uint64_t recordedHash;
+
+    void reopen();
+
+public:
+    ReplayLog();
+
+    // Recording (called by MLFQScheduler)
+    void begin(const SchedulerConfig& cfg, LastQueueAlgorithm algorithm);
+    void record(ReplayEvent::Type type, SimTime time, SimTime a, SimTime b = 0);
+    // A bulk run skipped the execution log, or restore() rewound the
+    // scheduler: the log can no longer be checked against a replay
+    void markIncomplete() { logComplete = false; }
+
+    // Stamp the end time and log hash; false and errorMsg set, leaving the
+    // recording unfinished, once markIncomplete() has been called
+    bool finish(const MLFQScheduler& scheduler, string& errorMsg);
+
+    // Getters
+    const SchedulerConfig& getConfig() const { return config; }
+    LastQueueAlgorithm getInitialAlgorithm() const { return initialAlgorithm; }
+    const vector<ReplayEvent>& getEvents() const { return events; }
+    bool isFinished() const { return finished; }
+    bool isLogComplete() const { return logComplete; }
+    uint64_t getRecordedHash() const { return recordedHash; }
+
+    // Run the recorded inputs on a new scheduler until the recorded end time
+    ReplayResult replay() const;
+    ReplayResult replay(MLFQScheduler& scheduler) const;  // scheduler is built from getConfig()
+
+    // Binary encoding; the decoders return false and set errorMsg on bad input
+    vector<uint8_t> serialize() const;
+    bool deserialize(const vector<uint8_t>& bytes, string& errorMsg);
+    bool save(const string& path, string& errorMsg) const;
+    bool load(const string& path, string& errorMsg);
+
+    // FNV-1a over the run-length compressed execution log
+    static uint64_t hashExecutionLog(const MLFQScheduler& scheduler);
+};
+
+#endif // REPLAY_LOG_H
@@ -1,9 +1,13 @@
 #ifndef SCHEDULER_CONFIG_H
 #define SCHEDULER_CONFIG_H
 
+#include "SimTime.h"
 #include <string>
 #include <iostream>
+#include <cstdint>
 #include <limits>
+#include <vector>
+#include <algorithm>
 using namespace std;
 
 enum class LastQueueAlgorithm
@@ -13,25 +17,45 @@ enum class LastQueueAlgorithm
     PRIORITY_SCHEDULING
 };
 
+// Which ranges SchedulerConfig::validate() enforces: DEMO keeps the small
+// workloads the visualizers can draw, SCALE only rejects nonsense
+enum class ConfigProfile
+{
+    DEMO,
+    SCALE
+};
+
 /**
   tunable parameters for the scheduling algorithm
 **/
 struct SchedulerConfig 
 {
     // Core MLFQ Parameters
-    int numQueues;              // Number of priority queues (2-5)
-    int boostInterval;          // Priority boost interval in ms (20-500)
-    int baseQuantum;            // Base time quantum for first queue (2-10)
+    int numQueues;              // Number of priority queues (2-64)
+    SimTime boostInterval;      // Priority boost interval in ms (20-500)
+    SimTime baseQuantum;        // Base time quantum for first queue (2-10)
     double quantumMultiplier;   // Growth factor for quantum (1.5, 2.0, 3.0)
+
+    // Time resolution: nanoseconds per unit of SimTime. Every time in this
+    // struct and in the scheduler is a count of these units (ticks), so
+    // TIME_NS gives nanosecond timestamps; toTicks() converts real durations
+    SimTime tickLength;         // TIME_MS by default
+
+    // Multi-core Parameters (MultiCoreScheduler only)
+    int numCores;               // Simulated CPUs (1-64)
+    SimTime migrationPenalty;   // Stall in ms when a process resumes on a different CPU (0-50)
     
     // Process Generation Parameters (for random/custom sets)
-    int numProcesses;           // Number of processes to generate (1-20)
-    int maxArrivalTime;         // Maximum arrival time window (0-100)
-    int minBurstTime;           // Minimum burst time (1-50)
-    int maxBurstTime;           // Maximum burst time (1-100)
+    long long numProcesses;     // Number of processes to generate (1-20)
+    SimTime maxArrivalTime;     // Maximum arrival time window (0-100)
+    SimTime minBurstTime;       // Minimum burst time (1-50)
+    SimTime maxBurstTime;       // Maximum burst time (1-100)
     
     // Visualization Parameters
     int animationDelay;         // Delay between steps in ms (50-1000)
+
+    // Ranges in the comments above are the DEMO limits
+    ConfigProfile profile;
     
     // Default constructor with standard MLFQ values
     SchedulerConfig() 
@@ -39,11 +63,15 @@ struct SchedulerConfig
           boostInterval(100),
           baseQuantum(4),
           quantumMultiplier(2.0),
+          tickLength(TIME_MS),
+          numCores(1),
+          migrationPenalty(0),
           numProcesses(5),
           maxArrivalTime(20),
           minBurstTime(5),
           maxBurstTime(30),
-          animationDelay(200) {}
+          animationDelay(200),
+          profile(ConfigProfile::DEMO) {}
     
     /**
      * Validate configuration parameters
@@ -51,9 +79,23 @@ struct SchedulerConfig
      */
     bool validate(string& errorMsg) const 
     {
-        if (numQueues < 2 || numQueues > 5) 
+        if (tickLength < 1)
+        {
+            errorMsg = "Tick length must be at least one nanosecond";
+            return false;
+        }
+        if (profile == ConfigProfile::SCALE)
+        {
+            return validateScale(errorMsg);
+        }
+        if (tickLength != TIME_MS)
         {
-            errorMsg = "Number of queues must be between 2 and 5";
+            errorMsg = "Demo runs count time in milliseconds";
+            return false;
+        }
+        if (numQueues < 2 || numQueues > 64) 
+        {
+            errorMsg = "Number of queues must be between 2 and 64";
             return false;
         }
         if (boostInterval < 20 || boostInterval > 500) 
@@ -71,6 +113,16 @@ struct SchedulerConfig
             errorMsg = "Quantum multiplier must be between 1.0 and 5.0";
             return false;
         }
+        if (numCores < 1 || numCores > 64) 
+        {
+            errorMsg = "Number of cores must be between 1 and 64";
+            return false;
+        }
+        if (migrationPenalty < 0 || migrationPenalty > 50) 
+        {
+            errorMsg = "Migration penalty must be between 0 and 50 ms";
+            return false;
+        }
         if (numProcesses < 1 || numProcesses > 20) 
         {
             errorMsg = "Number of processes must be between 1 and 20";
@@ -126,29 +178,133 @@ struct SchedulerConfig
     /**
      * Get quantum for a specific queue level
      */
-    int getQuantumForQueue(int queueLevel) const 
+    SimTime getQuantumForQueue(int queueLevel) const 
     {
-        int quantum = baseQuantum;
+        SimTime quantum = baseQuantum;
         for (int i = 0; i < queueLevel; i++) 
         {
-            quantum = static_cast<int>(quantum * quantumMultiplier);
+            quantum = nextQuantum(quantum);
         }
         return quantum;
     }
     
+    /**
+     * Quantums for every queue level, computed in one pass. Deep tables
+     * saturate at SIM_TIME_MAX instead of overflowing.
+     */
+    vector<SimTime> buildQuantumTable() const 
+    {
+        vector<SimTime> quantums;
+        quantums.reserve(numQueues > 0 ? numQueues : 0);
+        SimTime quantum = baseQuantum;
+        for (int i = 0; i < numQueues; i++) 
+        {
+            quantums.push_back(quantum);
+            quantum = nextQuantum(quantum);
+        }
+        return quantums;
+    }
+    
+    /**
+     * Ticks covering a real duration in nanoseconds, rounded up so a
+     * positive duration never becomes zero ticks
+     */
+    SimTime toTicks(SimTime nanoseconds) const
+    {
+        return nanoseconds / tickLength + (nanoseconds % tickLength > 0 ? 1 : 0);
+    }
+
+    // Real duration of a number of ticks, saturating at SIM_TIME_MAX
+    SimTime toNanoseconds(SimTime ticks) const
+    {
+        if (ticks > SIM_TIME_MAX / tickLength)
+        {
+            return SIM_TIME_MAX;
+        }
+        return ticks * tickLength;
+    }
+
+    // A tick count as a readable duration, e.g. "1.5 ms"
+    string formatTicks(SimTime ticks) const
+    {
+        return formatDuration(toNanoseconds(ticks));
+    }
+
     /**
      * Display quantum values for all queues
      */
     void displayQuantums() const 
     {
+        vector<SimTime> quantums = buildQuantumTable();
         cout << "  Time Quantums: ";
         for (int i = 0; i < numQueues; i++) 
         {
-            cout << "Q" << i << "=" << getQuantumForQueue(i) << "ms";
+            cout << "Q" << i << "=" << formatTicks(quantums[i]);
             if (i < numQueues - 1) cout << ", ";
         }
         cout << "\n";
     }
+
+private:
+    SimTime nextQuantum(SimTime quantum) const 
+    {
+        double next = quantum * quantumMultiplier;
+        if (next >= static_cast<double>(SIM_TIME_MAX)) 
+        {
+            return SIM_TIME_MAX;
+        }
+        return static_cast<SimTime>(next);
+    }
+
+    /**
+     * SCALE profile: any workload that fits in memory and in 64-bit time
+     */
+    bool validateScale(string& errorMsg) const
+    {
+        if (numQueues < 2 || numQueues > 64)
+        {
+            errorMsg = "Number of queues must be between 2 and 64";
+            return false;
+        }
+        if (boostInterval < 1 || baseQuantum < 1)
+        {
+            errorMsg = "Boost interval and base quantum must be positive";
+            return false;
+        }
+        if (!(quantumMultiplier >= 1.0) || quantumMultiplier > 1e6)
+        {
+            errorMsg = "Quantum multiplier must be between 1.0 and 1e6";
+            return false;
+        }
+        if (numCores < 1 || numCores > 1024)
+        {
+            errorMsg = "Number of cores must be between 1 and 1024";
+            return false;
+        }
+        if (migrationPenalty < 0)
+        {
+            errorMsg = "Migration penalty cannot be negative";
+            return false;
+        }
+        // Slots are 32-bit, with the top value reserved as NO_PROCESS
+        if (numProcesses < 1 || numProcesses >= static_cast<long long>(UINT32_MAX))
+        {
+            errorMsg = "Number of processes must be between 1 and " + to_string(UINT32_MAX - 1);
+            return false;
+        }
+        if (maxArrivalTime < 0 || minBurstTime < 1 || maxBurstTime < minBurstTime)
+        {
+            errorMsg = "Need 0 <= max arrival and 1 <= min burst <= max burst";
+            return false;
+        }
+        // Running every burst back to back after the last arrival must not wrap
+        if (maxBurstTime > (SIM_TIME_MAX - maxArrivalTime) / numProcesses)
+        {
+            errorMsg = "Workload could run past the end of 64-bit simulated time";
+            return false;
+        }
+        return true;
+    }
 };
 
 /**
@@ -172,11 +328,11 @@ public:
         cout <<   "╚═══════════════════════════════════════════════════════╝\n\n";
         
         // Core parameters
-        config.numQueues = getIntInput
+        config.numQueues = static_cast<int>(getIntInput
         (
-            "Number of queues [2-5]", 
-            config.numQueues, 2, 5
-        );
+            "Number of queues [2-64]", 
+            config.numQueues, 2, 64
+        ));
         
         config.baseQuantum = getIntInput
         (
@@ -224,11 +380,11 @@ public:
         
         cout << "\n--- Visualization Parameters ---\n";
         
-        config.animationDelay = getIntInput
+        config.animationDelay = static_cast<int>(getIntInput
         (
             "Animation delay (ms) [50-2000]", 
             config.animationDelay, 50, 2000
-        );
+        ));
         
         // Validate and display
         string errorMsg;
@@ -289,9 +445,31 @@ public:
         
         return config;
     }
+
+    /**
+     * Large trace replays: arrivals spread over a day, bursts from one tick
+     * up to a minute, capped so the CPU stays about 80% busy. Ticks are
+     * microseconds unless tickLength says otherwise
+     */
+    static SchedulerConfig getScaleProfile(long long numProcesses, SimTime tickLength = TIME_US)
+    {
+        SchedulerConfig config;
+        config.profile = ConfigProfile::SCALE;
+        config.tickLength = max<SimTime>(1, tickLength);
+        const SimTime day = config.toTicks(24 * TIME_H);
+        config.numQueues = 8;
+        config.baseQuantum = config.toTicks(TIME_MS);
+        config.quantumMultiplier = 4.0;
+        config.boostInterval = config.toTicks(TIME_S);
+        config.numProcesses = numProcesses;
+        config.maxArrivalTime = day;
+        config.minBurstTime = 1;
+        config.maxBurstTime = max<SimTime>(1, min<SimTime>(config.toTicks(TIME_MIN), day / max(1LL, numProcesses) * 8 / 5));
+        return config;
+    }
     
 private:
-    static int getIntInput(const string& prompt, int defaultValue, int min, int max) 
+    static long long getIntInput(const string& prompt, long long defaultValue, long long min, long long max) 
     {
         cout << prompt << " [" << defaultValue << "]: ";
         string input;
@@ -304,7 +482,7 @@ private:
         
         try 
         {
-            int value = stoi(input);
+            long long value = stoll(input);
 
             if (value < min || value > max) 
             {
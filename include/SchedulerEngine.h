@@ -0,0 +1,294 @@
+#ifndef SCHEDULER_ENGINE_H
+#define SCHEDULER_ENGINE_H
+
+// The templated scheduling core of MLFQScheduler. Included by
+// MLFQScheduler.cpp, and by callers that run the engine with their own
+// compile-time hooks (MLFQScheduler::runUntil(time, hooks))
+
+#include "MLFQScheduler.h"
+#include <algorithm>
+using namespace std;
+
+template <class LastOrder>
+void MLFQScheduler::makeReady(int level, ProcessSlot slot, SimTime enterTime)
+{
+    table.markReady(slot, enterTime);  // Wait clock starts when entering queue
+    table.setQueueEnterTime(slot, enterTime);
+    if (level == numQueues - 1)
+    {
+        readyQueues[level].push<LastOrder>(slot);
+    }
+    else
+    {
+        readyQueues[level].push<FifoOrder>(slot);  // Upper levels are round-robin
+    }
+    readyCount++;
+}
+
+template <class LastOrder, class Hooks>
+void MLFQScheduler::checkNewArrivals(Hooks& hooks)
+{
+    while (arrivalCursor < arrivalOrder.size())
+    {
+        ProcessSlot slot = arrivalOrder[arrivalCursor];
+        if (table.isRetired(slot))
+        {
+            arrivalCursor++;  // Cancelled before it arrived
+            continue;
+        }
+        if (table.getArrivalTime(slot) > currentTime)
+        {
+            break;
+        }
+        arrivalCursor++;
+        if (table.getState(slot) == ProcessState::NEW)
+        {
+            makeReady<LastOrder>(0, slot, currentTime);  // New processes start at highest priority
+            hooks.onArrival(table.view(slot), currentTime);
+        }
+    }
+}
+
+template <class LastOrder>
+ProcessSlot MLFQScheduler::selectNextProcess()
+{
+    // Rule 1: If priority(A) > priority(B), A runs before B.
+    // Upper queues are round-robin; the last queue serves in the order of
+    // the selected LastQueueAlgorithm (see setLastQueueAlgorithm)
+    int level = readyQueues.highestReadyLevel();
+    if (level < 0)
+    {
+        return NO_PROCESS;
+    }
+    if (level == numQueues - 1)
+    {
+        return readyQueues[level].pop<LastOrder>();
+    }
+    return readyQueues[level].pop<FifoOrder>();
+}
+
+template <class LastOrder, class Hooks>
+void MLFQScheduler::moveToNextQueue(Hooks& hooks, ProcessSlot slot)
+{
+    if (slot == NO_PROCESS || table.getState(slot) == ProcessState::TERMINATED)
+    {
+        return;
+    }
+
+    // Rule 3: When a process uses up its time slice, move to lower priority queue
+    int priority = table.getPriority(slot);
+    int nextPriority = min(priority + 1, numQueues - 1);
+    makeReady<LastOrder>(nextPriority, slot, currentTime);
+    if (nextPriority != priority)
+    {
+        hooks.onDemotion(table.view(slot), priority, nextPriority, currentTime);
+    }
+    else
+    {
+        hooks.onPreemption(table.view(slot), priority, currentTime);  // Round robin in the last queue
+    }
+}
+
+template <class LastOrder, class Hooks>
+bool MLFQScheduler::dispatchIfIdle(Hooks& hooks)
+{
+    if (currentSlot == NO_PROCESS || table.getState(currentSlot) == ProcessState::TERMINATED)
+    {
+        currentSlot = selectNextProcess<LastOrder>();
+        if (currentSlot == NO_PROCESS)
+        {
+            return false;
+        }
+        readyCount--;
+        int level = table.getPriority(currentSlot);
+        queueStats[level].dispatches++;
+        table.accrueWaitTime(currentSlot, currentTime);
+        // Set queue enter time only when newly selected
+        table.setQueueEnterTime(currentSlot, currentTime);
+        hooks.onDispatch(table.view(currentSlot), level, currentTime);
+    }
+    return true;
+}
+
+template <bool LogExecution, class LastOrder, class Hooks>
+void MLFQScheduler::runSlice(Hooks& hooks, SimTime timeSlice)
+{
+    // Execute current process
+    int queueLevel = table.getPriority(currentSlot);
+    SimTime timeQuantum = readyQueues[queueLevel].getTimeQuantum();
+
+    SimTime executionStart = currentTime;
+    SimTime executionEnd = currentTime + timeSlice;
+    table.execute(currentSlot, timeSlice, currentTime);
+    table.setLastRunTime(currentSlot, executionEnd - 1);
+
+    busyTime += timeSlice;
+    queueStats[queueLevel].busyTime += timeSlice;
+
+    // Log execution
+    if (LogExecution)
+    {
+        logExecution(table.getPid(currentSlot), executionStart, executionEnd, queueLevel);
+    }
+
+    // Update time first (before checking completion)
+    currentTime = executionEnd;
+
+    // Processes arriving mid-slice join queue 0 in arrival order
+    while (arrivalCursor < arrivalOrder.size())
+    {
+        ProcessSlot slot = arrivalOrder[arrivalCursor];
+        if (table.isRetired(slot))
+        {
+            arrivalCursor++;  // Cancelled before it arrived
+            continue;
+        }
+        if (table.getArrivalTime(slot) >= executionEnd)
+        {
+            break;
+        }
+        arrivalCursor++;
+        if (table.getState(slot) == ProcessState::NEW)
+        {
+            makeReady<LastOrder>(0, slot, table.getArrivalTime(slot));
+            hooks.onArrival(table.view(slot), table.getArrivalTime(slot));
+        }
+    }
+
+    // Calculate quantum usage and check completion status AFTER execution
+    SimTime timeUsedInQueue = currentTime - table.getQueueEnterTime(currentSlot);  // This now correctly measures time in queue
+    bool quantumExpired = (timeUsedInQueue >= timeQuantum);
+    bool processTerminated = (table.getState(currentSlot) == ProcessState::TERMINATED);  // This checks status after execution
+
+    // Priority boost check - only increment when CPU is active
+    boostTimer += timeSlice;
+    bool boosted = (boostTimer >= boostInterval);
+    if (boosted)
+    {
+        boostAllProcesses();
+        boostTimer = 0;
+        hooks.onBoost(currentTime);
+    }
+
+    // Handle completion or quantum expiration
+    if (processTerminated)
+    {
+        table.setCompletionTime(currentSlot, currentTime);
+        table.calculateMetrics(currentSlot, currentTime);
+        totalWaitTime += table.getWaitTime(currentSlot);
+        totalTurnaroundTime += table.getTurnaroundTime(currentSlot);
+        totalResponseTime += table.getResponseTime(currentSlot);
+        hooks.onCompletion(table.view(currentSlot), currentTime);
+        if (retention == CompletedRetention::KEEP)
+        {
+            completedSlots.push_back(currentSlot);
+        }
+        else
+        {
+            retire(currentSlot);
+        }
+        currentSlot = NO_PROCESS;
+    }
+    else if (boosted)
+    {
+        // Current process also gets boosted, so re-enqueue it
+        makeReady<LastOrder>(0, currentSlot, currentTime);
+        hooks.onPreemption(table.view(currentSlot), queueLevel, currentTime);
+        currentSlot = NO_PROCESS;
+    }
+    else if (quantumExpired)
+    {
+        // Process used up its time quantum
+        moveToNextQueue<LastOrder>(hooks, currentSlot);
+        currentSlot = NO_PROCESS;
+    }
+}
+
+template <bool LogExecution, class LastOrder, class Hooks>
+void MLFQScheduler::runLoop(Hooks& hooks, SimTime endTime, bool untilComplete, bool singleEvent)
+{
+    // Slices and idle jumps are clipped at endTime so the clock stops
+    // exactly where repeated step() calls would. Submitted jobs join before
+    // each event, so a run does not finish with some still waiting
+    for (;;)
+    {
+        acceptSubmissions();
+        if (untilComplete ? isComplete() : currentTime >= endTime)
+        {
+            return;
+        }
+        checkNewArrivals<LastOrder>(hooks);
+
+        if (!dispatchIfIdle<LastOrder>(hooks))
+        {
+            // Nothing is ready: skip the idle gap up to the next arrival
+            SimTime next = nextArrivalTime();
+            SimTime target = (next > currentTime) ? next : currentTime + 1;
+            currentTime = untilComplete ? target : min(target, endTime);
+        }
+        else
+        {
+            SimTime slice = nextSliceLength();
+            if (!untilComplete)
+            {
+                slice = min(slice, endTime - currentTime);
+            }
+            runSlice<LogExecution, LastOrder>(hooks, slice);
+        }
+
+        if (singleEvent)
+        {
+            return;
+        }
+    }
+}
+
+template <bool LogExecution, class LastOrder, bool Observed>
+void MLFQScheduler::runEngine(SimTime endTime, bool untilComplete, bool singleEvent)
+{
+    if (Observed)
+    {
+        ObserverHooks hooks = {observer};
+        runLoop<LogExecution, LastOrder>(hooks, endTime, untilComplete, singleEvent);
+    }
+    else
+    {
+        NoSchedulerHooks hooks;
+        runLoop<LogExecution, LastOrder>(hooks, endTime, untilComplete, singleEvent);
+    }
+}
+
+template <class Hooks>
+void MLFQScheduler::runWithHooks(Hooks& hooks, SimTime endTime, bool untilComplete)
+{
+    noteUnloggedRun();
+    switch (queueOrderFor(lastQueueAlgorithm))
+    {
+        case QueueOrder::SHORTEST_REMAINING_FIRST:
+            executionLogging ? runLoop<true, ShortestRemainingOrder>(hooks, endTime, untilComplete, false)
+                             : runLoop<false, ShortestRemainingOrder>(hooks, endTime, untilComplete, false);
+            break;
+        case QueueOrder::LONGEST_WAIT_FIRST:
+            executionLogging ? runLoop<true, LongestWaitOrder>(hooks, endTime, untilComplete, false)
+                             : runLoop<false, LongestWaitOrder>(hooks, endTime, untilComplete, false);
+            break;
+        case QueueOrder::FIFO:
+            executionLogging ? runLoop<true, FifoOrder>(hooks, endTime, untilComplete, false)
+                             : runLoop<false, FifoOrder>(hooks, endTime, untilComplete, false);
+            break;
+    }
+}
+
+template <class Hooks>
+void MLFQScheduler::runUntil(SimTime time, Hooks& hooks)
+{
+    runWithHooks(hooks, time, false);
+}
+
+template <class Hooks>
+void MLFQScheduler::runToCompletion(Hooks& hooks)
+{
+    runWithHooks(hooks, SIM_TIME_MAX, true);
+}
+
+#endif // SCHEDULER_ENGINE_H
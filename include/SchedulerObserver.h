@@ -0,0 +1,64 @@
+#ifndef SCHEDULER_OBSERVER_H
+#define SCHEDULER_OBSERVER_H
+
+#include "ProcessTable.h"
+#include "SimTime.h"
+
+/**
+ * Scheduling events, reported from inside the engine as they happen.
+ * Attach at runtime with MLFQScheduler::setObserver() and override only the
+ * events of interest; each event then costs one virtual call. Levels are
+ * queue levels (0 is the highest priority). Views are only valid during the
+ * call: a completed process may be retired right after onCompletion().
+ */
+class SchedulerObserver
+{
+public:
+    virtual ~SchedulerObserver() {}
+
+    // Admitted to queue 0 at its arrival time
+    virtual void onArrival(const ProcessView& /*process*/, SimTime /*time*/) {}
+    // Selected to run from level
+    virtual void onDispatch(const ProcessView& /*process*/, int /*level*/, SimTime /*time*/) {}
+    // Taken off the CPU unfinished without moving down: its quantum ran out
+    // in the last queue, or a boost interrupted it (level is where it ran)
+    virtual void onPreemption(const ProcessView& /*process*/, int /*level*/, SimTime /*time*/) {}
+    // Used up its quantum and moved to a lower level
+    virtual void onDemotion(const ProcessView& /*process*/, int /*fromLevel*/, int /*toLevel*/, SimTime /*time*/) {}
+    // Every process moved back to queue 0
+    virtual void onBoost(SimTime /*time*/) {}
+    // Finished its burst
+    virtual void onCompletion(const ProcessView& /*process*/, SimTime /*time*/) {}
+};
+
+/**
+ * Compile-time hooks: the engine is instantiated on a hooks type with the
+ * same member functions as SchedulerObserver (see
+ * MLFQScheduler::runUntil(time, hooks) in SchedulerEngine.h). Derive from
+ * NoSchedulerHooks to pick events; the empty ones inline away, and runs
+ * without hooks use NoSchedulerHooks itself.
+ */
+struct NoSchedulerHooks
+{
+    void onArrival(const ProcessView&, SimTime) {}
+    void onDispatch(const ProcessView&, int, SimTime) {}
+    void onPreemption(const ProcessView&, int, SimTime) {}
+    void onDemotion(const ProcessView&, int, int, SimTime) {}
+    void onBoost(SimTime) {}
+    void onCompletion(const ProcessView&, SimTime) {}
+};
+
+// Forwards the engine's hooks to a runtime observer
+struct ObserverHooks
+{
+    SchedulerObserver* observer;
+
+    void onArrival(const ProcessView& p, SimTime time) { observer->onArrival(p, time); }
+    void onDispatch(const ProcessView& p, int level, SimTime time) { observer->onDispatch(p, level, time); }
+    void onPreemption(const ProcessView& p, int level, SimTime time) { observer->onPreemption(p, level, time); }
+    void onDemotion(const ProcessView& p, int from, int to, SimTime time) { observer->onDemotion(p, from, to, time); }
+    void onBoost(SimTime time) { observer->onBoost(time); }
+    void onCompletion(const ProcessView& p, SimTime time) { observer->onCompletion(p, time); }
+};
+
+#endif // SCHEDULER_OBSERVER_H
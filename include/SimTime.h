@@ -0,0 +1,89 @@
+#ifndef SIM_TIME_H
+#define SIM_TIME_H
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Simulated time and durations. 64-bit, so a trace spanning days of
+// microseconds (or hours of nanoseconds) fits without wrapping
+typedef long long SimTime;
+const SimTime SIM_TIME_MAX = LLONG_MAX;
+
+// Real durations in nanoseconds. SchedulerConfig::tickLength says how many
+// of these one unit of SimTime stands for
+const SimTime TIME_NS = 1;
+const SimTime TIME_US = 1000 * TIME_NS;
+const SimTime TIME_MS = 1000 * TIME_US;
+const SimTime TIME_S = 1000 * TIME_MS;
+const SimTime TIME_MIN = 60 * TIME_S;
+const SimTime TIME_H = 60 * TIME_MIN;
+
+/**
+ * Parse a duration such as "250us", "1.5ms" or "2h" into nanoseconds.
+ * The unit (ns, us, ms, s, min, h) is required; false and errorMsg set when
+ * the text is not a non-negative duration that fits in SimTime.
+ */
+inline bool parseDuration(const std::string& text, SimTime& nanoseconds, std::string& errorMsg)
+{
+    const struct { const char* suffix; SimTime unit; } units[] =
+    {
+        {"ns", TIME_NS}, {"us", TIME_US}, {"ms", TIME_MS},
+        {"min", TIME_MIN}, {"s", TIME_S}, {"h", TIME_H}
+    };
+
+    char* end = nullptr;
+    double value = strtod(text.c_str(), &end);
+    std::string suffix(end);
+    for (const auto& unit : units)
+    {
+        if (suffix != unit.suffix)
+        {
+            continue;
+        }
+        double scaled = value * static_cast<double>(unit.unit);
+        if (end == text.c_str() || !(scaled >= 0) || scaled >= static_cast<double>(SIM_TIME_MAX))
+        {
+            errorMsg = "Duration out of range: " + text;
+            return false;
+        }
+        nanoseconds = static_cast<SimTime>(scaled + 0.5);
+        return true;
+    }
+    errorMsg = "Expected a duration with a unit (ns, us, ms, s, min, h): " + text;
+    return false;
+}
+
+// Nanoseconds in the largest unit that keeps the value at least 1, e.g. "1.5 ms"
+inline std::string formatDuration(SimTime nanoseconds)
+{
+    const struct { const char* suffix; SimTime unit; } units[] =
+    {
+        {"h", TIME_H}, {"s", TIME_S}, {"ms", TIME_MS}, {"us", TIME_US}
+    };
+
+    const char* suffix = "ns";
+    double value = static_cast<double>(nanoseconds);
+    for (const auto& unit : units)
+    {
+        if (nanoseconds >= unit.unit || -nanoseconds >= unit.unit)
+        {
+            suffix = unit.suffix;
+            value /= static_cast<double>(unit.unit);
+            break;
+        }
+    }
+
+    char buffer[48];
+    snprintf(buffer, sizeof(buffer), "%.3f", value);
+    std::string text(buffer);
+    text.erase(text.find_last_not_of('0') + 1);
+    if (text.back() == '.')
+    {
+        text.pop_back();
+    }
+    return text + " " + suffix;
+}
+
+#endif // SIM_TIME_H
@@ -0,0 +1,34 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+using namespace std;
+
+/**
+ * Reductions over contiguous int and 64-bit arrays, used to summarize the
+ * process table's SimTime columns. Each kernel has a scalar, an SSE2 and an
+ * AVX2 version; the widest one the CPU supports is picked on first use.
+ */
+namespace SimdKernels
+{
+    enum class InstructionSet
+    {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    long long sum(const int* values, size_t count);   // Widened, cannot overflow
+    size_t argMin(const int* values, size_t count);   // First smallest; count when empty
+    size_t argMax(const int* values, size_t count);   // First largest; count when empty
+    long long sum(const long long* values, size_t count);
+    size_t argMin(const long long* values, size_t count);
+    size_t argMax(const long long* values, size_t count);
+
+    InstructionSet detected();                        // Widest set this CPU supports
+    InstructionSet active();
+    bool select(InstructionSet set);                  // false if the CPU lacks it
+    const char* name(InstructionSet set);
+}
+
+#endif // SIMD_KERNELS_H
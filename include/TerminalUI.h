@@ -110,7 +110,7 @@ inline string formatKeyValue(const string& key, const string& value, int totalWi
 }
 
 // Progress bar with consistent styling
-inline string progressBar(int current, int total, int width = 20) {
+inline string progressBar(long long current, long long total, int width = 20) {
     if (total <= 0 || width <= 0) return string(width, ' ');
     
     double percentage = total > 0 ? static_cast<double>(current) / total : 0.0;
@@ -13,7 +13,7 @@ private:
     
     // Helper methods
     string getStateSymbol(ProcessState state) const;
-    string getProgressBar(int current, int total, int width) const;
+    string getProgressBar(SimTime current, SimTime total, int width) const;
     
 public:
     Visualizer(MLFQScheduler& sched, int width = 80);
@@ -8,9 +8,12 @@
 using namespace std;
 
 
+// Serves the web GUI files, and GET /submit?arrival=A&burst=B, which feeds
+// a job to the scheduler through submit() while another thread runs it
+// (runWebGUIMode drives the clock in real time)
 class WebServer {
 private:
-    MLFQScheduler* scheduler;
+    MLFQScheduler* scheduler;   // Only submit() is called from the server thread
     atomic<bool> running;
     thread serverThread;
     int port;
@@ -0,0 +1,240 @@
+#include "CompletionLog.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+using namespace std;
+
+namespace
+{
+    const char MAGIC[8] = {'M', 'L', 'F', 'Q', 'R', 'E', 'S', '1'};
+    const size_t HEADER_BYTES = sizeof(MAGIC);
+
+    void putFixed64(char* out, long long value)
+    {
+        uint64_t bits = static_cast<uint64_t>(value);
+        for (int i = 0; i < 8; i++)
+        {
+            out[i] = static_cast<char>(bits >> (8 * i));
+        }
+    }
+
+    long long getFixed64(const char* in)
+    {
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; i++)
+        {
+            bits |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+        }
+        return static_cast<long long>(bits);
+    }
+
+    void encode(char* out, const CompletedProcess& record)
+    {
+        putFixed64(out, record.pid);
+        putFixed64(out + 8, record.arrivalTime);
+        putFixed64(out + 16, record.burstTime);
+        putFixed64(out + 24, record.completionTime);
+        putFixed64(out + 32, record.turnaroundTime);
+        putFixed64(out + 40, record.waitTime);
+        putFixed64(out + 48, record.responseTime);
+    }
+
+    CompletedProcess decode(const char* in)
+    {
+        CompletedProcess record;
+        record.pid = static_cast<int>(getFixed64(in));
+        record.arrivalTime = getFixed64(in + 8);
+        record.burstTime = getFixed64(in + 16);
+        record.completionTime = getFixed64(in + 24);
+        record.turnaroundTime = getFixed64(in + 32);
+        record.waitTime = getFixed64(in + 40);
+        record.responseTime = getFixed64(in + 48);
+        return record;
+    }
+
+    streamoff recordOffset(size_t index)
+    {
+        return static_cast<streamoff>(HEADER_BYTES + index * CompletionLog::RECORD_BYTES);
+    }
+}
+
+CompletionLog::CompletionLog() : written(0), cacheStart(0), sharedCount(0), temporary(false) {}
+
+CompletionLog::~CompletionLog()
+{
+    if (temporary)
+    {
+        file.close();
+        error_code ignored;
+        filesystem::remove(path, ignored);
+        return;
+    }
+    flush();
+}
+
+bool CompletionLog::open(const string& filePath, string& errorMsg)
+{
+    if (file.is_open())
+    {
+        flush();
+        file.close();
+    }
+    path = filePath;
+    written = 0;
+    pending.clear();
+    cache.clear();
+    sharedCount = 0;
+    temporary = false;
+
+    file.open(path, ios::in | ios::out | ios::binary | ios::trunc);
+    if (!file.is_open())
+    {
+        errorMsg = "Could not create " + path;
+        return false;
+    }
+    file.write(MAGIC, HEADER_BYTES);
+    if (!file)
+    {
+        errorMsg = "Could not write " + path;
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+void CompletionLog::append(const CompletedProcess& record)
+{
+    pending.push_back(record);
+    if (pending.size() >= BLOCK_RECORDS)
+    {
+        flush();  // On failure the records stay pending and are retried
+    }
+}
+
+bool CompletionLog::flush()
+{
+    if (pending.empty() || !file.is_open())
+    {
+        return pending.empty();
+    }
+
+    vector<char> bytes(pending.size() * RECORD_BYTES);
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        encode(&bytes[i * RECORD_BYTES], pending[i]);
+    }
+
+    file.clear();
+    file.seekp(recordOffset(written));
+    file.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+    file.flush();
+    if (!file)
+    {
+        file.clear();
+        return false;
+    }
+    written += pending.size();
+    pending.clear();
+    return true;
+}
+
+CompletedProcess CompletionLog::operator[](size_t index) const
+{
+    if (index >= written)
+    {
+        return pending[index - written];
+    }
+
+    if (index < cacheStart || index >= cacheStart + cache.size())
+    {
+        cacheStart = index - index % BLOCK_RECORDS;
+        size_t count = written - cacheStart;
+        if (count > BLOCK_RECORDS)
+        {
+            count = BLOCK_RECORDS;
+        }
+        vector<char> bytes(count * RECORD_BYTES);
+
+        cache.clear();
+        file.clear();
+        file.seekg(recordOffset(cacheStart));
+        file.read(bytes.data(), static_cast<streamsize>(bytes.size()));
+        if (!file)
+        {
+            file.clear();
+            CompletedProcess missing = {-1, 0, 0, 0, 0, 0, 0};
+            return missing;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            cache.push_back(decode(&bytes[i * RECORD_BYTES]));
+        }
+    }
+    return cache[index - cacheStart];
+}
+
+void CompletionLog::truncate(size_t records)
+{
+    if (records >= written)
+    {
+        pending.resize(min(pending.size(), records - written));
+        return;
+    }
+
+    pending.clear();
+    cache.clear();
+    written = records;
+    file.flush();
+    error_code ignored;  // A longer file still reads correctly up to size()
+    filesystem::resize_file(path, static_cast<uintmax_t>(recordOffset(records)), ignored);
+}
+
+void CompletionLog::moveAside()
+{
+    // The open stream keeps reading the file under its new name
+    flush();
+    error_code error;
+    string aside;
+    for (int i = 1; ; i++)
+    {
+        aside = path + ".shared" + to_string(i);
+        if (!filesystem::exists(aside, error))
+        {
+            break;
+        }
+    }
+    filesystem::rename(path, aside, error);
+    if (!error)
+    {
+        path = aside;
+        temporary = true;
+        return;
+    }
+
+    // Where an open file cannot be renamed, keep the records in memory
+    vector<CompletedProcess> records;
+    records.reserve(size());
+    for (size_t i = 0; i < size(); i++)
+    {
+        records.push_back((*this)[i]);
+    }
+    pending.swap(records);
+    written = 0;
+    cache.clear();
+    file.close();
+}
+
+bool CompletionLog::branchFrom(CompletionLog& source, size_t records, string& errorMsg)
+{
+    string target = source.path;
+    source.moveAside();
+    if (!open(target, errorMsg))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < records; i++)
+    {
+        append(source[i]);
+    }
+    return true;
+}
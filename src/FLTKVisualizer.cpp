@@ -208,7 +208,7 @@ void FLTKVisualizer::updateQueueDisplays()
                 break;
             }
 
-            int progress = process->getBurstTime() - process->getRemainingTime();
+            SimTime progress = process->getBurstTime() - process->getRemainingTime();
             double percent = (process->getBurstTime() > 0) ?
                 (static_cast<double>(progress) * 100.0 / process->getBurstTime()) : 0.0;
 
@@ -247,7 +247,7 @@ void FLTKVisualizer::updateCurrentProcessDisplay()
     
     if (current && current->getState() != ProcessState::TERMINATED) 
     {
-        int progress = current->getBurstTime() - current->getRemainingTime();
+        SimTime progress = current->getBurstTime() - current->getRemainingTime();
         double percent = (current->getBurstTime() > 0) ? 
             (static_cast<double>(progress) * 100.0 / current->getBurstTime()) : 0.0;
         
@@ -342,7 +342,7 @@ void FLTKVisualizer::updateGanttDisplay()
             oss << " " << left << setw(7) << state << " |";
 
             // Progress - compact format
-            int completed = proc->getBurstTime() - proc->getRemainingTime();
+            SimTime completed = proc->getBurstTime() - proc->getRemainingTime();
             oss << " " << setw(2) << completed << "/" << setw(2) << proc->getBurstTime();
 
             if (proc != allProcs.back())
@@ -420,10 +420,7 @@ void FLTKVisualizer::handleAuto()
 
 void FLTKVisualizer::handleReset() 
 {
-    // Reset scheduler (clears all processes)
-    scheduler.reset();
-    
-    // Restore the initial processes
+    // Return to the state saved at startup (processes, queues and clock)
     restoreInitialProcesses();
     
     // Update display to show reset state
@@ -432,26 +429,13 @@ void FLTKVisualizer::handleReset()
 
 void FLTKVisualizer::saveInitialProcesses() 
 {
-    // Save the current processes configuration
-    initialProcesses.clear();
-    const auto& allProcs = scheduler.getAllProcesses();
-    
-    for (const auto& proc : allProcs) 
-    {
-        ProcessConfig config;
-        config.arrivalTime = proc->getArrivalTime();
-        config.burstTime = proc->getBurstTime();
-        initialProcesses.push_back(config);
-    }
+    // Copy-on-write snapshot; costs O(chunks), not O(processes)
+    initialState = scheduler.snapshot();
 }
 
 void FLTKVisualizer::restoreInitialProcesses() 
 {
-    // Re-add all the initial processes to the scheduler
-    for (const auto& config : initialProcesses) 
-    {
-        scheduler.addProcess(config.arrivalTime, config.burstTime);
-    }
+    scheduler.restore(initialState);
 }
 
 void FLTKVisualizer::handleQuit() 
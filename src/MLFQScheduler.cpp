@@ -1,14 +1,122 @@
 #include "MLFQScheduler.h"
+#include "ReplayLog.h"
+#include "SchedulerEngine.h"
 #include <algorithm>
 #include <iostream>
-#include <cmath>
 #include <climits>
+#include <cstdint>
 using namespace std;
 
+namespace
+{
+    const CompletionReport NO_COMPLETIONS = {-1, 0, -1, 0, -1, 0, -1, 0};
+
+    // Fold one completed process into report. Ties go to the lower pid,
+    // which is the process added first
+    void foldCompletion(CompletionReport& report, const CompletedProcess& p)
+    {
+        auto wins = [&p](SimTime value, SimTime best, int bestPid)
+        {
+            return bestPid < 0 || value > best || (value == best && p.pid < bestPid);
+        };
+        if (wins(p.waitTime, report.maxWaitTime, report.maxWaitPid))
+        {
+            report.maxWaitPid = p.pid;
+            report.maxWaitTime = p.waitTime;
+        }
+        if (wins(-p.turnaroundTime, -report.minTurnaroundTime, report.minTurnaroundPid))
+        {
+            report.minTurnaroundPid = p.pid;
+            report.minTurnaroundTime = p.turnaroundTime;
+        }
+        if (wins(p.turnaroundTime, report.maxTurnaroundTime, report.maxTurnaroundPid))
+        {
+            report.maxTurnaroundPid = p.pid;
+            report.maxTurnaroundTime = p.turnaroundTime;
+        }
+        if (wins(p.responseTime, report.maxResponseTime, report.maxResponsePid))
+        {
+            report.maxResponsePid = p.pid;
+            report.maxResponseTime = p.responseTime;
+        }
+    }
+
+    int bitWidth(uint64_t value)
+    {
+        int bits = 0;
+        while (bits < 64 && (value >> bits) != 0)
+        {
+            bits++;
+        }
+        return bits;
+    }
+
+    struct ArrivalKey
+    {
+        uint64_t key;       // Arrival time minus the earliest arrival
+        ProcessSlot slot;
+    };
+
+    // Stable LSD radix sort on bits [lowBit, highBit) of keyOf(item), in as
+    // few passes of at most 13 bits as cover the range (a day of
+    // microseconds takes three). Every pass's histogram is counted in one
+    // read, and a pass in which all keys share the digit is skipped
+    template <class T, class KeyOf>
+    void radixSort(vector<T>& items, int lowBit, int highBit, KeyOf keyOf)
+    {
+        const int MAX_DIGIT_BITS = 13;
+        int passes = (highBit - lowBit + MAX_DIGIT_BITS - 1) / MAX_DIGIT_BITS;
+        if (passes == 0)
+        {
+            return;
+        }
+        int digitBits = (highBit - lowBit + passes - 1) / passes;
+        size_t buckets = size_t(1) << digitBits;
+
+        vector<size_t> offsets(passes * buckets, 0);
+        for (const T& item : items)
+        {
+            uint64_t key = keyOf(item) >> lowBit;
+            for (int p = 0; p < passes; p++)
+            {
+                offsets[p * buckets + ((key >> (p * digitBits)) & (buckets - 1))]++;
+            }
+        }
+
+        vector<T> sorted(items.size());
+        for (int p = 0; p < passes; p++)
+        {
+            size_t* offset = &offsets[p * buckets];
+            if (*max_element(offset, offset + buckets) == items.size())
+            {
+                continue;
+            }
+            size_t total = 0;
+            for (size_t b = 0; b < buckets; b++)
+            {
+                size_t bucket = offset[b];
+                offset[b] = total;
+                total += bucket;
+            }
+            int shift = lowBit + p * digitBits;
+            for (const T& item : items)
+            {
+                sorted[offset[(keyOf(item) >> shift) & (buckets - 1)]++] = item;
+            }
+            items.swap(sorted);
+        }
+    }
+}
+
 // Legacy constructor
 MLFQScheduler::MLFQScheduler(int queues, int boost)
-    : currentProcess(nullptr), currentTime(0), boostTimer(0), boostInterval(boost), numQueues(queues),
-      pidCounter(1), lastQueueAlgorithm(LastQueueAlgorithm::ROUND_ROBIN) 
+    : currentSlot(NO_PROCESS), arrivalCursor(0), readyCount(0),
+      currentTime(0), boostTimer(0), boostInterval(boost), numQueues(queues),
+      pidCounter(1), lastQueueAlgorithm(LastQueueAlgorithm::ROUND_ROBIN),
+      executionLogging(true), recorder(nullptr), observer(nullptr),
+      submissions(new MpscQueue<JobSpec>()), retention(CompletedRetention::KEEP), ownsSpill(false),
+      spilledCount(0), retiredCount(0), retiredReport(NO_COMPLETIONS), cancelledCount(0),
+      totalWaitTime(0), totalTurnaroundTime(0), totalResponseTime(0), busyTime(0) 
 {
 
     // Create default config
@@ -16,426 +124,669 @@ MLFQScheduler::MLFQScheduler(int queues, int boost)
     config.numQueues = queues;
     config.boostInterval = boost;
 
-    // Initialize queues with different time quantums
-    int baseQuantum = config.baseQuantum;
-
-    for (int i = 0; i < numQueues; i++) 
-    {
-        int quantum = static_cast<int>(baseQuantum * pow(config.quantumMultiplier, i));
-        readyQueues.emplace_back(i, quantum);
-    }
+    initQueues();
+    selectEngines();
 }
 
 // Configuration-based constructor
 MLFQScheduler::MLFQScheduler(const SchedulerConfig& cfg)
-    : currentProcess(nullptr), currentTime(0), boostTimer(0),
+    : currentSlot(NO_PROCESS), arrivalCursor(0), readyCount(0), currentTime(0), boostTimer(0),
       boostInterval(cfg.boostInterval), numQueues(cfg.numQueues), pidCounter(1), config(cfg),
-      lastQueueAlgorithm(LastQueueAlgorithm::ROUND_ROBIN) 
+      lastQueueAlgorithm(LastQueueAlgorithm::ROUND_ROBIN),
+      executionLogging(true), recorder(nullptr), observer(nullptr),
+      submissions(new MpscQueue<JobSpec>()), retention(CompletedRetention::KEEP), ownsSpill(false),
+      spilledCount(0), retiredCount(0), retiredReport(NO_COMPLETIONS), cancelledCount(0),
+      totalWaitTime(0), totalTurnaroundTime(0), totalResponseTime(0), busyTime(0) 
 {
 
-    // Initialize queues using configuration
-    for (int i = 0; i < numQueues; i++) 
-    {
-        int quantum = config.getQuantumForQueue(i);
-        readyQueues.emplace_back(i, quantum);
-    }
-}
-
-void MLFQScheduler::addProcess(int arrivalTime, int burstTime) 
-{
-    auto process = make_shared<Process>(pidCounter++, arrivalTime, burstTime);
-    allProcesses.push_back(process);
+    initQueues();
+    selectEngines();
 }
 
-void MLFQScheduler::addProcess(shared_ptr<Process> process) 
+MLFQScheduler::MLFQScheduler(const MLFQScheduler& other)
+    : table(other.table), readyQueues(other.readyQueues), completedSlots(other.completedSlots),
+      currentSlot(other.currentSlot), arrivalOrder(other.arrivalOrder),
+      arrivalCursor(other.arrivalCursor), readyCount(other.readyCount),
+      currentTime(other.currentTime), boostTimer(other.boostTimer),
+      boostInterval(other.boostInterval), numQueues(other.numQueues),
+      pidCounter(other.pidCounter), config(other.config),
+      lastQueueAlgorithm(other.lastQueueAlgorithm), executionLogging(other.executionLogging),
+      recorder(nullptr), observer(nullptr), submissions(new MpscQueue<JobSpec>()),
+      retention(other.retention == CompletedRetention::SPILL ? CompletedRetention::KEEP : other.retention),
+      spill(other.spill), ownsSpill(false), spilledCount(other.spilledCount),
+      retiredCount(other.retiredCount), retiredReport(other.retiredReport),
+      cancelledCount(other.cancelledCount),
+      executionLog(other.executionLog),
+      totalWaitTime(other.totalWaitTime), totalTurnaroundTime(other.totalTurnaroundTime),
+      totalResponseTime(other.totalResponseTime), busyTime(other.busyTime),
+      queueStats(other.queueStats)
 {
-    if (process) 
+    readyQueues.bindTable(&table);
+    selectEngines();
+    if (spill)
     {
-        allProcesses.push_back(process);
+        spill->share(spilledCount);
     }
 }
 
-void MLFQScheduler::checkNewArrivals() 
+MLFQScheduler& MLFQScheduler::operator=(const MLFQScheduler& other)
 {
-    for (auto& process : allProcesses) 
+    if (this != &other)
     {
-        if (process->getArrivalTime() == currentTime && process->getState() == ProcessState::NEW) 
+        // Restoring a state of this run keeps writing the spill file from
+        // where that state left it; any other state stops spilling
+        bool keepSpill = ownsSpill && spill == other.spill;
+        CompletedRetention policy = retention;
+
+        table = other.table;
+        readyQueues = other.readyQueues;
+        readyQueues.bindTable(&table);
+        completedSlots = other.completedSlots;
+        currentSlot = other.currentSlot;
+        arrivalOrder = other.arrivalOrder;
+        arrivalCursor = other.arrivalCursor;
+        readyCount = other.readyCount;
+        currentTime = other.currentTime;
+        boostTimer = other.boostTimer;
+        boostInterval = other.boostInterval;
+        numQueues = other.numQueues;
+        pidCounter = other.pidCounter;
+        config = other.config;
+        lastQueueAlgorithm = other.lastQueueAlgorithm;
+        executionLogging = other.executionLogging;
+        executionLog = other.executionLog;   // recorder, observer and submissions stay with this scheduler
+        selectEngines();
+        totalWaitTime = other.totalWaitTime;
+        totalTurnaroundTime = other.totalTurnaroundTime;
+        totalResponseTime = other.totalResponseTime;
+        busyTime = other.busyTime;
+        queueStats = other.queueStats;
+        spill = other.spill;
+        spilledCount = other.spilledCount;
+        retiredCount = other.retiredCount;
+        retiredReport = other.retiredReport;
+        cancelledCount = other.cancelledCount;
+        if (keepSpill)
         {
-            process->setState(ProcessState::READY);  // Set to READY when entering queue
-            process->setQueueEnterTime(currentTime);
-            readyQueues[0].enqueue(process);  // New processes start at highest priority
+            retention = policy;
+            rewindSpill(spilledCount);
+            if (retention != CompletedRetention::KEEP)
+            {
+                retireCompleted();
+            }
+        }
+        else
+        {
+            ownsSpill = false;
+            retention = other.retention == CompletedRetention::SPILL ? CompletedRetention::KEEP : other.retention;
+            if (spill)
+            {
+                spill->share(spilledCount);
+            }
         }
     }
+    return *this;
 }
 
-shared_ptr<Process> MLFQScheduler::selectNextProcess() 
+SchedulerSnapshot MLFQScheduler::snapshot() const
 {
-    // Rule 1: If priority(A) > priority(B), A runs before B
-    const size_t queueCount = readyQueues.size();
-    for (size_t i = 0; i < queueCount; i++)
+    SchedulerSnapshot snap;
+    snap.state = make_shared<MLFQScheduler>(*this);
+    return snap;
+}
+
+void MLFQScheduler::restore(const SchedulerSnapshot& snap)
+{
+    if (snap.state)
     {
-        if (!readyQueues[i].isEmpty())
+        *this = *snap.state;
+        if (recorder)
         {
-            // For the last queue, use the selected algorithm
-            if (i == queueCount - 1)
-            {  // Last queue
-                return selectNextProcessForLastQueue();
-            }
-             else
-             {
-                // For other queues, use standard round-robin (FIFO)
-                auto process = readyQueues[i].dequeue();
-                return process;
-            }
+            recorder->markIncomplete();
+            recorder = nullptr;
         }
     }
-    return nullptr;
 }
 
-shared_ptr<Process> MLFQScheduler::selectNextProcessForLastQueue()
+void MLFQScheduler::setBoostInterval(SimTime interval)
 {
-    if (readyQueues.empty()) return nullptr;
-
-    int lastQueueIndex = readyQueues.size() - 1;
-    auto& lastQueue = readyQueues[lastQueueIndex];
-
-    if (lastQueue.isEmpty()) return nullptr;
+    // A timer already past the new interval boosts on the next active tick
+    boostInterval = max<SimTime>(1, interval);
+    config.boostInterval = boostInterval;
+    if (recorder)
+    {
+        recorder->record(ReplayEvent::SET_BOOST_INTERVAL, currentTime, boostInterval);
+    }
+}
 
-    shared_ptr<Process> selectedProcess = nullptr;
+void MLFQScheduler::setRecorder(ReplayLog* log)
+{
+    recorder = log;
+    if (recorder)
+    {
+        recorder->begin(config, lastQueueAlgorithm);
+    }
+}
 
-    switch (lastQueueAlgorithm)
+void MLFQScheduler::setRetention(CompletedRetention policy)
+{
+    if (policy == CompletedRetention::SPILL && !ownsSpill)
     {
-        case LastQueueAlgorithm::ROUND_ROBIN:
-        {
-            // Standard round-robin: take first process (FIFO), so we dequeue it
-            return lastQueue.dequeue();  // This removes and returns the first process
-        }
+        return;  // Needs a file of our own; see setSpillFile()
+    }
+    retention = policy;
+    if (retention != CompletedRetention::KEEP)
+    {
+        retireCompleted();
+    }
+}
 
-        case LastQueueAlgorithm::SHORTEST_JOB_FIRST:
-        {
-            // Find process with shortest remaining time
-            auto processes = lastQueue.getProcesses(); // Get a copy to sort
-            // Sort by remaining time (shortest first)
-            sort(processes.begin(), processes.end(),
-                [](const shared_ptr<Process>& a, const shared_ptr<Process>& b) 
-                {
-                    return a->getRemainingTime() < b->getRemainingTime();
-                });
-
-            // The first process in the sorted list is the one to execute
-            selectedProcess = processes[0];
-            break;
-        }
+bool MLFQScheduler::setSpillFile(const string& path, string& errorMsg)
+{
+    shared_ptr<CompletionLog> log = make_shared<CompletionLog>();
+    if (!log->open(path, errorMsg))
+    {
+        return false;
+    }
+    spill = log;
+    ownsSpill = true;
+    spilledCount = 0;
+    retention = CompletedRetention::SPILL;
+    retireCompleted();
+    return true;
+}
 
-        case LastQueueAlgorithm::PRIORITY_SCHEDULING:
+void MLFQScheduler::rewindSpill(size_t records)
+{
+    // Copies that read past records keep the old file, and this run goes on
+    // in a new one. If that cannot be created, it stops spilling like a copy
+    if (spill.use_count() > 1 && spill->getSharedCount() > records)
+    {
+        shared_ptr<CompletionLog> log = make_shared<CompletionLog>();
+        string error;
+        if (!log->branchFrom(*spill, records, error))
         {
-            // Find the highest priority process (longest waiting time)
-            auto processes = lastQueue.getProcesses(); // Get a copy to sort
-            // Sort by priority (longest waiting time first)
-            sort(processes.begin(), processes.end(),
-                [](const shared_ptr<Process>& a, const shared_ptr<Process>& b) 
-                {
-                    // Priority = actual wait time (aging for anti-starvation)
-                    return a->getWaitTime() > b->getWaitTime(); // Higher wait time first
-                });
-
-            // The first process in the sorted list is the one to execute
-            selectedProcess = processes[0];
-            break;
+            ownsSpill = false;
+            if (retention == CompletedRetention::SPILL)
+            {
+                retention = CompletedRetention::KEEP;
+            }
+            return;
         }
+        spill = log;
+        return;
     }
+    spill->truncate(records);
+}
 
-    // For SJF and Priority Scheduling, remove the selected process to return it
-    if (selectedProcess)
+void MLFQScheduler::retire(ProcessSlot slot)
+{
+    CompletedProcess record = table.completed(slot);
+    foldCompletion(retiredReport, record);
+    if (retention == CompletedRetention::SPILL)
     {
-        lastQueue.removeProcess(selectedProcess->getPid());
+        spill->append(record);
+        spilledCount++;
     }
-    return selectedProcess;
+    table.retire(slot);
+    retiredCount++;
+
+    // Admitted arrivals are never looked at again
+    arrivalOrder.discardBefore(arrivalCursor);
 }
 
-void MLFQScheduler::setLastQueueAlgorithm(LastQueueAlgorithm algorithm)
+ProcessView MLFQScheduler::findProcess(int pid) const
 {
-    lastQueueAlgorithm = algorithm;
+    ProcessSlot slot = table.findPid(pid);
+    return slot == NO_PROCESS ? ProcessView() : table.view(slot);
 }
 
-
-void MLFQScheduler::moveToNextQueue(shared_ptr<Process> process)
+bool MLFQScheduler::cancelProcess(int pid)
 {
-    if (!process || process->getState() == ProcessState::TERMINATED)
+    ProcessSlot slot = table.findPid(pid);
+    if (slot == NO_PROCESS || table.getState(slot) == ProcessState::TERMINATED)
     {
-        return;
+        return false;
+    }
+    if (recorder)
+    {
+        recorder->record(ReplayEvent::CANCEL_PROCESS, currentTime, pid);
     }
 
-    // Rule 3: When a process uses up its time slice, move to lower priority queue
-    int currentPriority = process->getPriority();
-    int nextPriority = min(currentPriority + 1, numQueues - 1);
+    if (slot == currentSlot)
+    {
+        currentSlot = NO_PROCESS;
+    }
+    else if (table.getState(slot) == ProcessState::READY)
+    {
+        readyQueues[table.getPriority(slot)].removeSlot(slot);
+        readyCount--;
+    }
+    // A process yet to arrive stays in arrivalOrder; admission skips it
+    table.retire(slot);
+    cancelledCount++;
+
+    // Keep the cursor on a live process so nextArrivalTime() can read it
+    while (arrivalCursor < arrivalOrder.size() && table.isRetired(arrivalOrder[arrivalCursor]))
+    {
+        arrivalCursor++;
+    }
+    return true;
+}
 
-    process->setPriority(nextPriority);
-    process->setState(ProcessState::READY);  // Set to READY when moved to queue
-    process->setQueueEnterTime(currentTime);
+bool MLFQScheduler::setBurst(int pid, SimTime burstTime)
+{
+    ProcessSlot slot = table.findPid(pid);
+    if (slot == NO_PROCESS || table.getState(slot) == ProcessState::TERMINATED ||
+        burstTime <= table.getCpuTimeUsed(slot))
+    {
+        return false;
+    }
+    if (recorder)
+    {
+        recorder->record(ReplayEvent::SET_BURST, currentTime, pid, burstTime);
+    }
 
-    // For SJF and Priority Scheduling in the last queue, we need special handling
-    if (nextPriority == numQueues - 1 && lastQueueAlgorithm != LastQueueAlgorithm::ROUND_ROBIN)
+    table.setBurst(slot, burstTime);
+    if (slot != currentSlot && table.getState(slot) == ProcessState::READY)
     {
-        // Instead of using a separate method, let's insert the process in the correct position directly
-        insertProcessIntoLastQueueByAlgorithm(process);
+        readyQueues[table.getPriority(slot)].rekey(slot);  // SJF keys on remaining time
     }
-    else
+    return true;
+}
+
+void MLFQScheduler::retireCompleted()
+{
+    for (ProcessSlot slot : completedSlots)
     {
-        readyQueues[nextPriority].enqueue(process);
+        retire(slot);
     }
+    completedSlots.clear();
 }
 
-void MLFQScheduler::insertProcessIntoLastQueueByAlgorithm(shared_ptr<Process> process)
+void MLFQScheduler::initQueues()
 {
-    if (!process) return;
+    // The ready bitmap has one bit per level
+    numQueues = max(1, min(numQueues, MultilevelQueue::MAX_LEVELS));
+    config.numQueues = numQueues;
+
+    // Initialize queues with the precomputed quantum table
+    readyQueues = MultilevelQueue(config.buildQuantumTable());
+    readyQueues.bindTable(&table);
+    queueStats.assign(numQueues, QueueStats{0, 0});
+}
 
-    int lastQueueIndex = numQueues - 1;
-    auto& lastQueue = readyQueues[lastQueueIndex];
+void MLFQScheduler::addProcess(SimTime arrivalTime, SimTime burstTime) 
+{
+    if (recorder)
+    {
+        recorder->record(ReplayEvent::ADD_PROCESS, currentTime, arrivalTime, burstTime);
+    }
+    indexArrival(table.add(pidCounter++, arrivalTime, burstTime));
+}
+
+void MLFQScheduler::addProcess(const Process& process) 
+{
+    addProcess(process.getArrivalTime(), process.getBurstTime());
+}
 
-    // Get the current list of processes in the last queue
-    auto processes = lastQueue.getProcesses();
+void MLFQScheduler::reserve(size_t processes)
+{
+    table.reserve(processes);
+    arrivalOrder.reserve(processes);
+    if (retention == CompletedRetention::KEEP)
+    {
+        completedSlots.reserve(processes);
+    }
+    readyQueues[numQueues - 1].reserve(processes);  // Only the last level can be ordered
+}
 
-    // Find the correct insertion point based on the algorithm
-    switch (lastQueueAlgorithm)
+void MLFQScheduler::loadWorkload(const JobSpec* jobs, size_t count)
+{
+    if (count == 0)
     {
-        case LastQueueAlgorithm::SHORTEST_JOB_FIRST:
+        return;
+    }
+    size_t first = table.size();
+    reserve(first + count);
+
+    // Table rows in input order, so pids are what addProcess() would give
+    SimTime earliest = jobs[0].arrivalTime;
+    SimTime latest = earliest;
+    bool inOrder = true;
+    for (size_t i = 0; i < count; i++)
+    {
+        const JobSpec& job = jobs[i];
+        if (recorder)
         {
-            // Find where to insert based on remaining time (shortest first)
-            auto insertPos = processes.begin();
-            for (; insertPos != processes.end(); ++insertPos) 
-            {
-                if ((*insertPos)->getRemainingTime() > process->getRemainingTime()) 
-                {
-                    break;
-                }
-            }
-            processes.insert(insertPos, process);
-            break;
+            recorder->record(ReplayEvent::ADD_PROCESS, currentTime, job.arrivalTime, job.burstTime);
         }
-        case LastQueueAlgorithm::PRIORITY_SCHEDULING:
+        table.add(pidCounter++, job.arrivalTime, job.burstTime);
+        inOrder = inOrder && job.arrivalTime >= latest;
+        earliest = min(earliest, job.arrivalTime);
+        latest = max(latest, job.arrivalTime);
+    }
+
+    // New slots in arrival order. Keys are relative to the earliest arrival
+    // (the unsigned difference is exact). When key and input index fit in
+    // one word they are sorted packed together, halving the memory traffic
+    vector<ProcessSlot> sorted(count);
+    int keyBits = bitWidth(static_cast<uint64_t>(latest) - static_cast<uint64_t>(earliest));
+    int indexBits = bitWidth(count - 1);
+    auto keyOf = [&](size_t i)
+    {
+        return static_cast<uint64_t>(jobs[i].arrivalTime) - static_cast<uint64_t>(earliest);
+    };
+    if (inOrder)
+    {
+        for (size_t i = 0; i < count; i++)
         {
-            // Find where to insert based on priority (longest waiting time first)
-            int processPriority = currentTime - process->getArrivalTime();
-            auto insertPos = processes.begin();
-            for (; insertPos != processes.end(); ++insertPos) 
-            {
-                int currentPriority = currentTime - (*insertPos)->getArrivalTime();
-                if (currentPriority < processPriority) 
-                {  // Higher priority value comes first
-                    break;
-                }
-            }
-            processes.insert(insertPos, process);
-            break;
+            sorted[i] = static_cast<ProcessSlot>(first + i);
+        }
+    }
+    else if (keyBits + indexBits <= 64)
+    {
+        vector<uint64_t> packed(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            packed[i] = (keyOf(i) << indexBits) | i;
+        }
+        radixSort(packed, indexBits, indexBits + keyBits, [](uint64_t item) { return item; });
+        uint64_t indexMask = (indexBits == 64) ? ~0ULL : (1ULL << indexBits) - 1;
+        for (size_t i = 0; i < count; i++)
+        {
+            sorted[i] = static_cast<ProcessSlot>(first + (packed[i] & indexMask));
+        }
+    }
+    else
+    {
+        vector<ArrivalKey> keys(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            keys[i] = {keyOf(i), static_cast<ProcessSlot>(first + i)};
+        }
+        radixSort(keys, 0, keyBits, [](const ArrivalKey& k) { return k.key; });
+        for (size_t i = 0; i < count; i++)
+        {
+            sorted[i] = keys[i].slot;
         }
-        default:
-            // Round Robin is handled by regular enqueue
-            lastQueue.enqueue(process);
-            return;
     }
 
-    // Clear and repopulate the queue in the correct order
-    lastQueue.clear();
-    for (const auto& proc : processes)
+    // Pending entries arriving after the earliest new job are merged with
+    // the new ones, earlier additions first on equal arrival times as with
+    // addProcess(). Loading before a run, or in arrival order, only appends.
+    // Cancelled entries are dropped, as admission would skip them anyway
+    size_t kept = arrivalOrder.size();
+    while (kept > arrivalCursor && (table.isRetired(arrivalOrder[kept - 1]) ||
+                                    table.getArrivalTime(arrivalOrder[kept - 1]) > earliest))
     {
-        lastQueue.enqueue(proc);
+        kept--;
+    }
+    vector<ProcessSlot> pending;
+    for (size_t i = kept; i < arrivalOrder.size(); i++)
+    {
+        if (!table.isRetired(arrivalOrder[i]))
+        {
+            pending.push_back(arrivalOrder[i]);
+        }
+    }
+    while (arrivalOrder.size() > kept)
+    {
+        arrivalOrder.pop_back();
     }
-}
 
-void MLFQScheduler::boostAllProcesses() 
-{
-    // Rule 4: After time period S, move all processes to highest priority queue
-    for (int i = 1; i < numQueues; i++) 
+    if (!pending.empty())
     {
-        auto& queue = readyQueues[i];
-        while (!queue.isEmpty()) 
+        vector<ProcessSlot> merged;
+        merged.reserve(pending.size() + count);
+        size_t next = 0;
+        for (ProcessSlot slot : sorted)
         {
-            auto process = queue.dequeue();
-            if (process && process->getState() != ProcessState::TERMINATED) 
+            SimTime arrival = jobs[slot - first].arrivalTime;
+            while (next < pending.size() && table.getArrivalTime(pending[next]) <= arrival)
             {
-                process->resetToHighestPriority();
-                process->setState(ProcessState::READY);  // Set to READY when boosted
-                readyQueues[0].enqueue(process);
+                merged.push_back(pending[next++]);
             }
+            merged.push_back(slot);
         }
+        merged.insert(merged.end(), pending.begin() + next, pending.end());
+        sorted.swap(merged);
     }
+    arrivalOrder.append(sorted.data(), sorted.size());
 }
 
-void MLFQScheduler::updateWaitTimes() 
+void MLFQScheduler::drainSubmissions()
 {
-    for (auto& queue : readyQueues) 
+    submissions->drain([this](const JobSpec& job)
     {
-        for (const auto& process : queue.getProcesses()) 
+        addProcess(job.arrivalTime, job.burstTime);
+    });
+}
+
+void MLFQScheduler::indexArrival(ProcessSlot slot)
+{
+    // Keep arrivalOrder sorted by arrival time, preserving insertion order for
+    // equal arrivals. Workloads are usually added in arrival order, so this is
+    // normally an append. A process whose arrival time has already passed
+    // lands at the cursor and is admitted on the next tick.
+    SimTime arrival = table.getArrivalTime(slot);
+    auto pos = upper_bound(arrivalOrder.begin() + arrivalCursor, arrivalOrder.end(), arrival,
+        [this](SimTime time, ProcessSlot other)
         {
-            if (process->getState() == ProcessState::READY) 
-            {
-                process->incrementWaitTime();
-            }
-        }
+            return time < table.getArrivalTime(other);
+        });
+    arrivalOrder.insert(pos - arrivalOrder.begin(), slot);
+}
+
+QueueOrder queueOrderFor(LastQueueAlgorithm algorithm)
+{
+    switch (algorithm)
+    {
+        case LastQueueAlgorithm::SHORTEST_JOB_FIRST:
+            return QueueOrder::SHORTEST_REMAINING_FIRST;   // Shortest remaining time first
+        case LastQueueAlgorithm::PRIORITY_SCHEDULING:
+            return QueueOrder::LONGEST_WAIT_FIRST;         // Aging: longest wait first
+        case LastQueueAlgorithm::ROUND_ROBIN:
+        default:
+            return QueueOrder::FIFO;
     }
 }
 
-void MLFQScheduler::step() 
+template <class LastOrder>
+void MLFQScheduler::selectEnginesFor()
 {
-    // Check for new arrivals
-    checkNewArrivals();
+    if (observer)
+    {
+        tickEngine = &MLFQScheduler::runEngine<true, LastOrder, true>;
+        bulkEngine = executionLogging ? tickEngine : &MLFQScheduler::runEngine<false, LastOrder, true>;
+    }
+    else
+    {
+        tickEngine = &MLFQScheduler::runEngine<true, LastOrder, false>;
+        bulkEngine = executionLogging ? tickEngine : &MLFQScheduler::runEngine<false, LastOrder, false>;
+    }
+}
 
-    // If no current process, select next one
-    if (!currentProcess || currentProcess->getState() == ProcessState::TERMINATED) 
+void MLFQScheduler::selectEngines()
+{
+    switch (queueOrderFor(lastQueueAlgorithm))
     {
-        currentProcess = selectNextProcess();
-        if (!currentProcess) 
-        {
-            currentTime++;
-            return;  // Idle time - don't count boost timer during idle
-        }
-        // Set queue enter time only when newly selected
-        currentProcess->setQueueEnterTime(currentTime);
+        case QueueOrder::SHORTEST_REMAINING_FIRST:
+            selectEnginesFor<ShortestRemainingOrder>();
+            break;
+        case QueueOrder::LONGEST_WAIT_FIRST:
+            selectEnginesFor<LongestWaitOrder>();
+            break;
+        case QueueOrder::FIFO:
+            selectEnginesFor<FifoOrder>();
+            break;
     }
+}
 
-    // Execute current process
-    int queueLevel = currentProcess->getPriority();
-    int timeQuantum = readyQueues[queueLevel].getTimeQuantum();
-    int timeSlice = 1;  // Execute 1 time unit at a time for visualization
+void MLFQScheduler::setObserver(SchedulerObserver* obs)
+{
+    observer = obs;
+    selectEngines();
+}
 
-    int executionStart = currentTime;
-    currentProcess->execute(timeSlice, currentTime);
+void MLFQScheduler::setExecutionLogging(bool enabled)
+{
+    executionLogging = enabled;
+    selectEngines();
+}
 
-    // Log execution
-    executionLog.push_back(
+void MLFQScheduler::setLastQueueAlgorithm(LastQueueAlgorithm algorithm)
+{
+    lastQueueAlgorithm = algorithm;
+    readyQueues.back().setOrder(queueOrderFor(algorithm));
+    selectEngines();
+    if (recorder)
     {
-        currentProcess->getPid(),
-        executionStart,
-        currentTime + timeSlice,
-        queueLevel
-    });
-
-    // Update time first (before checking completion)
-    currentTime++;
+        recorder->record(ReplayEvent::SET_ALGORITHM, currentTime, static_cast<int>(algorithm));
+    }
+}
 
-    // Update wait times for other processes AFTER time increment
-    updateWaitTimes();
 
-    // Calculate quantum usage and check completion status AFTER execution
-    int timeUsedInQueue = currentTime - currentProcess->getQueueEnterTime();  // This now correctly measures time in queue
-    bool quantumExpired = (timeUsedInQueue >= timeQuantum);
-    bool processTerminated = (currentProcess->getState() == ProcessState::TERMINATED);  // This checks status after execution
+void MLFQScheduler::boostAllProcesses() 
+{
+    // Rule 4: After time period S, move all processes to highest priority queue.
+    // Queued processes resolve their priority against the boost epoch, so the
+    // boost itself only relinks each lower level onto the tail of queue 0,
+    // keeping level order and FIFO order within each level
+    table.advanceBoostEpoch();
+    for (int i = 1; i < numQueues; i++) 
+    {
+        readyQueues[0].splice(readyQueues[i]);
+    }
+}
 
-    // Priority boost check - only increment when CPU is active
-    boostTimer++;
-    if (boostTimer >= boostInterval)
+SimTime MLFQScheduler::nextArrivalTime() const
+{
+    if (arrivalCursor < arrivalOrder.size())
     {
-        boostAllProcesses();
-        boostTimer = 0;
-        // Current process also gets boosted, so re-enqueue it
-        if (currentProcess && !processTerminated)
-        {
-            currentProcess->resetToHighestPriority();
-            currentProcess->setState(ProcessState::READY);  // Set to READY when boosted
-            currentProcess->setQueueEnterTime(currentTime);
-            readyQueues[0].enqueue(currentProcess);
-            currentProcess = nullptr;
-        }
+        return table.getArrivalTime(arrivalOrder[arrivalCursor]);
     }
-    else
+    return -1;
+}
+
+SimTime MLFQScheduler::nextSliceLength() const
+{
+    // The running process is never preempted by arrivals, so the next decision
+    // happens at the earliest of completion, quantum expiry and priority boost
+    int queueLevel = table.getPriority(currentSlot);
+    SimTime timeQuantum = readyQueues[queueLevel].getTimeQuantum();
+    SimTime quantumLeft = timeQuantum - (currentTime - table.getQueueEnterTime(currentSlot));
+    SimTime boostLeft = boostInterval - boostTimer;
+
+    SimTime slice = min(table.getRemainingTime(currentSlot), min(quantumLeft, boostLeft));
+    return max<SimTime>(slice, 1);
+}
+
+void MLFQScheduler::logExecution(int pid, SimTime startTime, SimTime endTime, int queueLevel)
+{
+    // Extend the previous span when the same process keeps running at the same level
+    if (!executionLog.empty())
     {
-        // Handle completion or quantum expiration
-        if (processTerminated)
+        const auto& last = executionLog.back();
+        if (last.pid == pid && last.queueLevel == queueLevel && last.endTime == startTime)
         {
-            currentProcess->setCompletionTime(currentTime);
-            currentProcess->calculateMetrics(currentTime);
-            completedProcesses.push_back(currentProcess);
-            currentProcess = nullptr;
-        }
-        else if (quantumExpired)
-        {
-            // Process used up its time quantum
-            moveToNextQueue(currentProcess);
-            currentProcess = nullptr;
+            executionLog.mutableBack().endTime = endTime;
+            return;
         }
     }
+    executionLog.push_back({pid, startTime, endTime, queueLevel});
 }
 
-bool MLFQScheduler::hasProcesses() const 
+vector<MLFQScheduler::ExecutionRecord> MLFQScheduler::getExecutionTicks() const
 {
-    // Check if there are processes in ready queues
-    for (const auto& queue : readyQueues) 
+    vector<ExecutionRecord> ticks;
+    for (const auto& span : executionLog)
     {
-        if (!queue.isEmpty()) 
+        for (SimTime t = span.startTime; t < span.endTime; t++)
         {
-            return true;
+            ticks.push_back({span.pid, t, t + 1, span.queueLevel});
         }
     }
-    
-    // Check if current process is running
-    if (currentProcess && currentProcess->getState() != ProcessState::TERMINATED) 
+    return ticks;
+}
+
+void MLFQScheduler::step() 
+{
+    // One time unit: a single event with the clock stopped one unit ahead.
+    // Idle time advances the clock without counting towards the boost timer
+    (this->*tickEngine)(currentTime + 1, false, true);
+}
+
+void MLFQScheduler::stepEvent()
+{
+    // Jump to the next arrival, quantum expiry, completion or boost
+    (this->*tickEngine)(SIM_TIME_MAX, false, true);
+}
+
+void MLFQScheduler::noteUnloggedRun()
+{
+    if (recorder && !executionLogging)
     {
-        return true;
+        recorder->markIncomplete();
     }
-    
-    // Check if there are processes yet to arrive
-    for (const auto& process : allProcesses) 
+}
+
+void MLFQScheduler::runUntil(SimTime time)
+{
+    noteUnloggedRun();
+    (this->*bulkEngine)(time, false, false);
+}
+
+void MLFQScheduler::runSteps(SimTime steps)
+{
+    if (steps <= 0)
     {
-        if (process->getArrivalTime() > currentTime) 
-        {
-            return true;
-        }
+        return;
     }
-    
-    return false;
+    runUntil(currentTime > SIM_TIME_MAX - steps ? SIM_TIME_MAX : currentTime + steps);
+}
+
+void MLFQScheduler::runToCompletion()
+{
+    noteUnloggedRun();
+    (this->*bulkEngine)(SIM_TIME_MAX, true, false);
+}
+
+bool MLFQScheduler::hasProcesses() const 
+{
+    // Ready, running, or yet to arrive
+    bool running = currentSlot != NO_PROCESS && table.getState(currentSlot) != ProcessState::TERMINATED;
+    return readyCount > 0 || running || arrivalCursor < arrivalOrder.size();
 }
 
 bool MLFQScheduler::isComplete() const 
 {
-    return completedProcesses.size() == allProcesses.size();
+    return completedSlots.size() == table.liveCount();
 }
 
 SchedulerStats MLFQScheduler::getStats() const 
 {
-    SchedulerStats stats = {0, 0, 0, 0, 0, 0, 0};
+    SchedulerStats stats = {0, 0, 0, 0, 0, 0, 0, 0};
 
-    stats.totalProcesses = allProcesses.size();
-    stats.completedProcesses = completedProcesses.size();
+    stats.totalProcesses = table.size() - cancelledCount;  // Retired completions included
+    stats.completedProcesses = completedSlots.size() + retiredCount;
     stats.currentTime = currentTime;
+    stats.cpuBusyTime = busyTime;
 
-    if (completedProcesses.empty()) 
+    if (stats.completedProcesses == 0) 
     {
         return stats;
     }
 
-    int totalWait = 0, totalTurnaround = 0, totalResponse = 0;
-
-    for (const auto& process : completedProcesses) 
-    {
-        totalWait += process->getWaitTime();
-        totalTurnaround += process->getTurnaroundTime();
-        totalResponse += process->getResponseTime();
-    }
-
-    int count = completedProcesses.size();
-    stats.avgWaitTime = static_cast<double>(totalWait) / count;
-    stats.avgTurnaroundTime = static_cast<double>(totalTurnaround) / count;
-    stats.avgResponseTime = static_cast<double>(totalResponse) / count;
+    double count = static_cast<double>(stats.completedProcesses);
+    stats.avgWaitTime = totalWaitTime / count;
+    stats.avgTurnaroundTime = totalTurnaroundTime / count;
+    stats.avgResponseTime = totalResponseTime / count;
 
     if (currentTime > 0)
     {
         // CPU Utilization = (actual CPU time used) / (total time) * 100
-        // Only count time for processes that have actually executed
-
-        int totalCpuTimeUsed = 0;
-        for (const auto& process : completedProcesses)
-        {
-            totalCpuTimeUsed += process->getBurstTime();  // Completed processes used all their burst time
-        }
-
-        if (currentProcess && currentProcess->getState() != ProcessState::TERMINATED)
-        {
-            // Add time used by currently running process
-            totalCpuTimeUsed += (currentProcess->getBurstTime() - currentProcess->getRemainingTime());
-        }
-
-        stats.cpuUtilization = (static_cast<double>(totalCpuTimeUsed) / currentTime) * 100.0;
+        stats.cpuUtilization = (static_cast<double>(busyTime) / currentTime) * 100.0;
 
         // Cap at 100% to avoid display issues
         if (stats.cpuUtilization > 100.0)
@@ -447,20 +798,78 @@ SchedulerStats MLFQScheduler::getStats() const
     return stats;
 }
 
+CompletionReport MLFQScheduler::getCompletionReport() const
+{
+    if (retiredCount == 0 && !completedSlots.empty() && completedSlots.size() == table.size())
+    {
+        // Every slot has completed, so each column is a dense run of results
+        ProcessSlot last = static_cast<ProcessSlot>(table.size());
+        ProcessSlot maxWait = table.argMaxColumn(ProcessColumn::WAIT_TIME, 0, last);
+        ProcessSlot minTurnaround = table.argMinColumn(ProcessColumn::TURNAROUND_TIME, 0, last);
+        ProcessSlot maxTurnaround = table.argMaxColumn(ProcessColumn::TURNAROUND_TIME, 0, last);
+        ProcessSlot maxResponse = table.argMaxColumn(ProcessColumn::RESPONSE_TIME, 0, last);
+
+        CompletionReport report;
+        report.maxWaitPid = table.getPid(maxWait);
+        report.maxWaitTime = table.getWaitTime(maxWait);
+        report.minTurnaroundPid = table.getPid(minTurnaround);
+        report.minTurnaroundTime = table.getTurnaroundTime(minTurnaround);
+        report.maxTurnaroundPid = table.getPid(maxTurnaround);
+        report.maxTurnaroundTime = table.getTurnaroundTime(maxTurnaround);
+        report.maxResponsePid = table.getPid(maxResponse);
+        report.maxResponseTime = table.getResponseTime(maxResponse);
+        return report;
+    }
+
+    // Retired processes are already folded in; the completed slots still
+    // held are scattered mid-run, so visit just those
+    CompletionReport report = retiredReport;
+    for (ProcessSlot slot : completedSlots)
+    {
+        foldCompletion(report, table.completed(slot));
+    }
+    return report;
+}
+
 void MLFQScheduler::reset() 
 {
     currentTime = 0;
     boostTimer = 0;
     pidCounter = 1;  // Reset PID counter
-    currentProcess = nullptr;
-    completedProcesses.clear();
+    currentSlot = NO_PROCESS;
+    completedSlots.clear();
+    retiredCount = 0;
+    spilledCount = 0;
+    retiredReport = NO_COMPLETIONS;
+    cancelledCount = 0;
+    if (ownsSpill)
+    {
+        rewindSpill(0);
+    }
+    if (!ownsSpill)
+    {
+        spill.reset();  // Records of the run this was copied from
+    }
     executionLog.clear();
-    allProcesses.clear();  // Clear all processes
+    table.clear();  // Clear all processes
+    arrivalOrder.clear();
+    arrivalCursor = 0;
+    readyCount = 0;
+    totalWaitTime = 0;
+    totalTurnaroundTime = 0;
+    totalResponseTime = 0;
+    busyTime = 0;
+    queueStats.assign(numQueues, QueueStats{0, 0});
     
     for (auto& queue : readyQueues) 
     {
         queue.clear();
     }
+
+    if (recorder)
+    {
+        recorder->begin(config, lastQueueAlgorithm);  // A new run starts a new recording
+    }
 }
 
 // Destructor
@@ -0,0 +1,379 @@
+#include "MultiCoreScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+using namespace std;
+
+MultiCoreScheduler::MultiCoreScheduler(const SchedulerConfig& cfg)
+    : arrivalCursor(0), currentTime(0), boostTimer(0), boostInterval(cfg.boostInterval),
+      numQueues(cfg.numQueues), numCores(cfg.numCores), migrationPenalty(cfg.migrationPenalty),
+      pidCounter(1), config(cfg), lastQueueAlgorithm(LastQueueAlgorithm::ROUND_ROBIN),
+      totalWaitTime(0), totalTurnaroundTime(0), totalResponseTime(0), busyTime(0)
+{
+    // Same limits as MLFQScheduler: one ready bit per level
+    numQueues = max(1, min(numQueues, MultilevelQueue::MAX_LEVELS));
+    numCores = max(1, numCores);
+    migrationPenalty = max<SimTime>(0, migrationPenalty);
+    config.numQueues = numQueues;
+    config.numCores = numCores;
+
+    vector<SimTime> quantums = config.buildQuantumTable();
+    cores.reserve(numCores);
+    for (int c = 0; c < numCores; c++)
+    {
+        cores.push_back(Core{MultilevelQueue(quantums), NO_PROCESS, 0, 0, CoreStats{0, 0, 0, 0, 0}});
+        cores.back().readyQueues.bindTable(&table);
+    }
+}
+
+void MultiCoreScheduler::setLastQueueAlgorithm(LastQueueAlgorithm algorithm)
+{
+    lastQueueAlgorithm = algorithm;
+    for (auto& core : cores)
+    {
+        core.readyQueues.back().setOrder(queueOrderFor(algorithm));
+    }
+}
+
+void MultiCoreScheduler::addProcess(SimTime arrivalTime, SimTime burstTime)
+{
+    ProcessSlot slot = table.add(pidCounter++, arrivalTime, burstTime);
+    lastCore.push_back(-1);
+    indexArrival(slot);
+}
+
+void MultiCoreScheduler::reserve(size_t processes)
+{
+    table.reserve(processes);
+    lastCore.reserve(processes);
+    arrivalOrder.reserve(processes);
+    completedSlots.reserve(processes);
+}
+
+void MultiCoreScheduler::indexArrival(ProcessSlot slot)
+{
+    // Sorted by arrival, insertion order for ties (see MLFQScheduler::indexArrival)
+    SimTime arrival = table.getArrivalTime(slot);
+    auto pos = upper_bound(arrivalOrder.begin() + arrivalCursor, arrivalOrder.end(), arrival,
+        [this](SimTime time, ProcessSlot other)
+        {
+            return time < table.getArrivalTime(other);
+        });
+    arrivalOrder.insert(pos, slot);
+}
+
+void MultiCoreScheduler::makeReady(int core, int level, ProcessSlot slot)
+{
+    table.markReady(slot, currentTime);
+    table.setQueueEnterTime(slot, currentTime);
+    cores[core].readyQueues[level].enqueue(slot);
+    cores[core].readyCount++;
+}
+
+int MultiCoreScheduler::leastLoadedCore() const
+{
+    int best = 0;
+    size_t bestLoad = SIZE_MAX;
+    for (int c = 0; c < numCores; c++)
+    {
+        size_t load = cores[c].readyCount + (cores[c].currentSlot != NO_PROCESS ? 1 : 0);
+        if (load < bestLoad)
+        {
+            best = c;
+            bestLoad = load;
+        }
+    }
+    return best;
+}
+
+int MultiCoreScheduler::busiestPeer(int core) const
+{
+    // Only running peers: an idle one dispatches its own queue this tick
+    int victim = -1;
+    size_t most = 0;
+    for (int c = 0; c < numCores; c++)
+    {
+        if (c != core && cores[c].currentSlot != NO_PROCESS && cores[c].readyCount > most)
+        {
+            victim = c;
+            most = cores[c].readyCount;
+        }
+    }
+    return victim;
+}
+
+void MultiCoreScheduler::checkNewArrivals()
+{
+    while (arrivalCursor < arrivalOrder.size())
+    {
+        ProcessSlot slot = arrivalOrder[arrivalCursor];
+        if (table.getArrivalTime(slot) > currentTime)
+        {
+            break;
+        }
+        arrivalCursor++;
+        if (table.getState(slot) == ProcessState::NEW)
+        {
+            makeReady(leastLoadedCore(), 0, slot);
+        }
+    }
+}
+
+ProcessSlot MultiCoreScheduler::steal(int core)
+{
+    // Take the process the busiest peer would have run next
+    int victim = busiestPeer(core);
+    if (victim < 0)
+    {
+        return NO_PROCESS;
+    }
+
+    Core& from = cores[victim];
+    ProcessSlot slot = from.readyQueues[from.readyQueues.highestReadyLevel()].dequeue();
+    from.readyCount--;
+    cores[core].stats.steals++;
+    return slot;
+}
+
+bool MultiCoreScheduler::dispatchIfIdle(int core, bool maySteal)
+{
+    Core& self = cores[core];
+    if (self.currentSlot != NO_PROCESS)
+    {
+        return true;
+    }
+
+    ProcessSlot slot = NO_PROCESS;
+    int level = self.readyQueues.highestReadyLevel();
+    if (level >= 0)
+    {
+        slot = self.readyQueues[level].dequeue();
+        self.readyCount--;
+    }
+    else if (maySteal)
+    {
+        slot = steal(core);
+    }
+    if (slot == NO_PROCESS)
+    {
+        return false;
+    }
+
+    // Resuming away from the core it last ran on costs the migration penalty;
+    // the quantum starts once the penalty is paid
+    SimTime penalty = 0;
+    if (lastCore[slot] >= 0 && lastCore[slot] != core)
+    {
+        penalty = migrationPenalty;
+        self.stats.migrations++;
+    }
+    lastCore[slot] = core;
+
+    table.accrueWaitTime(slot, currentTime);
+    table.setState(slot, ProcessState::RUNNING);
+    table.setQueueEnterTime(slot, currentTime + penalty);
+    self.currentSlot = slot;
+    self.stallLeft = penalty;
+    self.stats.dispatches++;
+    return true;
+}
+
+void MultiCoreScheduler::boostAllCores()
+{
+    // Rule 4 across all cores: one epoch bump covers every queued process,
+    // then each core splices its lower levels onto its own queue 0
+    table.advanceBoostEpoch();
+    for (auto& core : cores)
+    {
+        for (int i = 1; i < numQueues; i++)
+        {
+            core.readyQueues[0].splice(core.readyQueues[i]);
+        }
+    }
+}
+
+void MultiCoreScheduler::finishTick(int core, bool boosted)
+{
+    Core& self = cores[core];
+    ProcessSlot slot = self.currentSlot;
+    if (slot == NO_PROCESS)
+    {
+        return;
+    }
+
+    int level = table.getPriority(slot);
+    SimTime timeQuantum = self.readyQueues[level].getTimeQuantum();
+    bool quantumExpired = (currentTime - table.getQueueEnterTime(slot) >= timeQuantum);
+
+    if (table.getState(slot) == ProcessState::TERMINATED)
+    {
+        table.setCompletionTime(slot, currentTime);
+        table.calculateMetrics(slot, currentTime);
+        completedSlots.push_back(slot);
+        totalWaitTime += table.getWaitTime(slot);
+        totalTurnaroundTime += table.getTurnaroundTime(slot);
+        totalResponseTime += table.getResponseTime(slot);
+        self.currentSlot = NO_PROCESS;
+    }
+    else if (boosted)
+    {
+        makeReady(core, 0, slot);
+        self.currentSlot = NO_PROCESS;
+        self.stallLeft = 0;
+    }
+    else if (quantumExpired)
+    {
+        makeReady(core, min(level + 1, numQueues - 1), slot);
+        self.currentSlot = NO_PROCESS;
+    }
+}
+
+void MultiCoreScheduler::step()
+{
+    checkNewArrivals();
+
+    // Every core first dispatches from its own queues; only then do the
+    // cores left idle steal, so no core takes work a peer was about to run
+    for (int c = 0; c < numCores; c++)
+    {
+        dispatchIfIdle(c, false);
+    }
+
+    // Then each core runs one time unit, in core order
+    bool active = false;
+    for (int c = 0; c < numCores; c++)
+    {
+        if (!dispatchIfIdle(c, true))
+        {
+            continue;
+        }
+        active = true;
+
+        Core& core = cores[c];
+        if (core.stallLeft > 0)
+        {
+            core.stallLeft--;
+            core.stats.migrationTime++;
+            continue;
+        }
+
+        table.execute(core.currentSlot, 1, currentTime);
+        core.stats.busyTime++;
+        busyTime++;
+    }
+
+    currentTime++;
+    if (!active)
+    {
+        return;  // Idle time - don't count boost timer during idle
+    }
+
+    // The boost timer is shared, so every core is boosted at the same instant
+    boostTimer++;
+    bool boosted = (boostTimer >= boostInterval);
+    if (boosted)
+    {
+        boostAllCores();
+        boostTimer = 0;
+    }
+
+    for (int c = 0; c < numCores; c++)
+    {
+        finishTick(c, boosted);
+    }
+}
+
+bool MultiCoreScheduler::isComplete() const
+{
+    return completedSlots.size() == table.size();
+}
+
+ProcessView MultiCoreScheduler::getCurrentProcess(int core) const
+{
+    ProcessSlot slot = cores[core].currentSlot;
+    return slot == NO_PROCESS ? ProcessView() : table.view(slot);
+}
+
+SchedulerStats MultiCoreScheduler::getStats() const
+{
+    SchedulerStats stats = {0, 0, 0, 0, 0, 0, 0, 0};
+
+    stats.totalProcesses = table.size();
+    stats.completedProcesses = completedSlots.size();
+    stats.currentTime = currentTime;
+    stats.cpuBusyTime = busyTime;
+
+    if (currentTime > 0)
+    {
+        stats.cpuUtilization = static_cast<double>(busyTime) / (static_cast<double>(currentTime) * numCores) * 100.0;
+    }
+
+    if (!completedSlots.empty())
+    {
+        double count = static_cast<double>(completedSlots.size());
+        stats.avgWaitTime = totalWaitTime / count;
+        stats.avgTurnaroundTime = totalTurnaroundTime / count;
+        stats.avgResponseTime = totalResponseTime / count;
+    }
+
+    return stats;
+}
+
+double MultiCoreScheduler::getCoreUtilization(int core) const
+{
+    if (currentTime == 0)
+    {
+        return 0.0;
+    }
+    return static_cast<double>(cores[core].stats.busyTime) / currentTime * 100.0;
+}
+
+SimTime MultiCoreScheduler::getTurnaroundPercentile(double percentile) const
+{
+    if (completedSlots.empty())
+    {
+        return 0;
+    }
+
+    vector<SimTime> turnaround;
+    turnaround.reserve(completedSlots.size());
+    for (ProcessSlot slot : completedSlots)
+    {
+        turnaround.push_back(table.getTurnaroundTime(slot));
+    }
+
+    // Nearest-rank percentile
+    size_t n = turnaround.size();
+    size_t rank = static_cast<size_t>(ceil(percentile / 100.0 * n));
+    size_t index = min(n - 1, rank > 0 ? rank - 1 : 0);
+    nth_element(turnaround.begin(), turnaround.begin() + index, turnaround.end());
+    return turnaround[index];
+}
+
+void MultiCoreScheduler::reset()
+{
+    currentTime = 0;
+    boostTimer = 0;
+    pidCounter = 1;
+    table.clear();
+    lastCore.clear();
+    completedSlots.clear();
+    arrivalOrder.clear();
+    arrivalCursor = 0;
+    totalWaitTime = 0;
+    totalTurnaroundTime = 0;
+    totalResponseTime = 0;
+    busyTime = 0;
+
+    for (auto& core : cores)
+    {
+        for (auto& queue : core.readyQueues)
+        {
+            queue.clear();
+        }
+        core.currentSlot = NO_PROCESS;
+        core.readyCount = 0;
+        core.stallLeft = 0;
+        core.stats = CoreStats{0, 0, 0, 0, 0};
+    }
+}
@@ -3,13 +3,13 @@
 #include <iomanip>
 using namespace std;
 
-Process::Process(int id, int arrival, int burst)
+Process::Process(int id, SimTime arrival, SimTime burst)
     : pid(id), priority(0), arrivalTime(arrival), burstTime(burst),
       remainingTime(burst), cpuTimeUsed(0), lastRunTime(0), queueEnterTime(0),
-      waitTime(0), turnaroundTime(0), responseTime(-1),
+      readySince(0), waitTime(0), turnaroundTime(0), responseTime(-1),
       completionTime(0), firstRun(true), state(ProcessState::NEW) {}
 
-void Process::execute(int timeSlice, int currentTime) 
+void Process::execute(SimTime timeSlice, SimTime currentTime) 
 {
     if (firstRun) 
     {
@@ -20,7 +20,7 @@ void Process::execute(int timeSlice, int currentTime)
     state = ProcessState::RUNNING;
     lastRunTime = currentTime;
     
-    int executionTime = min(timeSlice, remainingTime);
+    SimTime executionTime = min(timeSlice, remainingTime);
     remainingTime -= executionTime;
     cpuTimeUsed += executionTime;
     
@@ -33,7 +33,31 @@ void Process::execute(int timeSlice, int currentTime)
     // The scheduler will set it to READY when the process is moved to a queue
 }
 
-void Process::calculateMetrics(int currentTime) 
+SimTime Process::getWaitTimeAt(SimTime currentTime) const
+{
+    if (state == ProcessState::READY)
+    {
+        return waitTime + (currentTime - readySince);
+    }
+    return waitTime;
+}
+
+void Process::markReady(SimTime currentTime)
+{
+    state = ProcessState::READY;
+    readySince = currentTime;
+}
+
+void Process::accrueWaitTime(SimTime currentTime)
+{
+    if (state == ProcessState::READY)
+    {
+        waitTime += currentTime - readySince;
+        readySince = currentTime;
+    }
+}
+
+void Process::calculateMetrics(SimTime currentTime) 
 {
     if (state == ProcessState::TERMINATED) 
     {
@@ -59,6 +83,7 @@ void Process::reset()
     cpuTimeUsed = 0;
     lastRunTime = 0;
     queueEnterTime = 0;
+    readySince = 0;
     waitTime = 0;
     turnaroundTime = 0;
     responseTime = -1;
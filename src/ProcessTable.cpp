@@ -0,0 +1,325 @@
+#include "ProcessTable.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+using namespace std;
+
+ProcessTable::ProcessTable(const ProcessTable& other) : count(0), retiredCount(0)
+{
+    *this = other;
+}
+
+ProcessTable& ProcessTable::operator=(const ProcessTable& other)
+{
+    if (this != &other)
+    {
+        // Share the chunks in use; the first write to one clones it
+        size_t used = (other.count + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+        hot.assign(other.hot.begin(), other.hot.begin() + used);
+        statics.assign(other.statics.begin(), other.statics.begin() + used);
+        reports.assign(other.reports.begin(), other.reports.begin() + used);
+        resident.assign(other.resident.begin(), other.resident.begin() + used);
+        count = other.count;
+        retiredCount = other.retiredCount;
+        boostEpoch = other.boostEpoch;
+    }
+    return *this;
+}
+
+ProcessSlot ProcessTable::add(int processId, SimTime arrival, SimTime burst)
+{
+    if (count == capacity())
+    {
+        reserve(count + 1);
+    }
+
+    ProcessSlot s = static_cast<ProcessSlot>(count++);
+    size_t i = offset(s);
+    size_t chunk = s >> CHUNK_SHIFT;
+    if (!hot[chunk])
+    {
+        // Freed when its processes were retired; a reused table needs it back
+        hot[chunk] = make_shared<HotChunk>();
+        statics[chunk] = make_shared<StaticChunk>();
+        reports[chunk].reset();
+    }
+    if (i == 0)
+    {
+        resident[chunk] = 0;  // Chunk is being filled afresh
+    }
+    resident[chunk]++;
+
+    StaticChunk& fixed = staticChunk(s);
+    fixed.pid[i] = processId;
+    fixed.arrivalTime[i] = arrival;
+    fixed.burstTime[i] = burst;
+    fixed.retired[i] = false;
+
+    HotChunk& c = hotChunk(s);
+    c.priority[i] = 0;
+    c.priorityEpoch[i] = boostEpoch;
+    c.state[i] = ProcessState::NEW;
+    c.remainingTime[i] = burst;
+    c.queueEnterTime[i] = 0;
+    c.readySince[i] = 0;
+    c.waitTime[i] = 0;
+    c.responseTime[i] = -1;
+    c.lastRunTime[i] = 0;
+    c.queueSlot[i] = -1;
+    c.queueSeq[i] = 0;
+    c.queuePrev[i] = s;
+    c.queueNext[i] = s;
+
+    // A reused slot may have a stale report from the previous workload
+    if (reports[chunk])
+    {
+        ReportChunk& r = reportChunk(s);
+        r.completionTime[i] = 0;
+        r.turnaroundTime[i] = 0;
+    }
+    return s;
+}
+
+void ProcessTable::reserve(size_t processes)
+{
+    while (capacity() < processes)
+    {
+        hot.emplace_back(new HotChunk);
+        statics.emplace_back(new StaticChunk);
+        reports.emplace_back();
+        resident.push_back(0);
+    }
+}
+
+void ProcessTable::release()
+{
+    hot.clear();
+    statics.clear();
+    reports.clear();
+    resident.clear();
+    count = 0;
+    retiredCount = 0;
+}
+
+void ProcessTable::retire(ProcessSlot s)
+{
+    staticChunk(s).retired[offset(s)] = true;
+    retiredCount++;
+
+    // Free a filled chunk once none of its slots is live; copies that
+    // share it keep their own reference
+    size_t chunk = s >> CHUNK_SHIFT;
+    if (--resident[chunk] == 0 && count >= (chunk + 1) * CHUNK_SIZE)
+    {
+        hot[chunk].reset();
+        statics[chunk].reset();
+        reports[chunk].reset();
+    }
+}
+
+CompletedProcess ProcessTable::completed(ProcessSlot s) const
+{
+    CompletedProcess record;
+    record.pid = getPid(s);
+    record.arrivalTime = getArrivalTime(s);
+    record.burstTime = getBurstTime(s);
+    record.completionTime = getCompletionTime(s);
+    record.turnaroundTime = getTurnaroundTime(s);
+    record.waitTime = getWaitTime(s);
+    record.responseTime = getResponseTime(s);
+    return record;
+}
+
+ProcessTable::ReportChunk& ProcessTable::reportChunk(ProcessSlot s)
+{
+    shared_ptr<ReportChunk>& r = reports[s >> CHUNK_SHIFT];
+    if (!r)
+    {
+        r = make_shared<ReportChunk>();  // Zeroed: processes still running read 0
+        return *r;
+    }
+    return writable(reports, s);
+}
+
+const SimTime* ProcessTable::columnData(ProcessColumn column, size_t chunk) const
+{
+    const ReportChunk* r = reports[chunk].get();
+    switch (column)
+    {
+        case ProcessColumn::REMAINING_TIME:
+            return hot[chunk]->remainingTime;
+        case ProcessColumn::WAIT_TIME:
+            return hot[chunk]->waitTime;
+        case ProcessColumn::RESPONSE_TIME:
+            return hot[chunk]->responseTime;
+        case ProcessColumn::COMPLETION_TIME:
+            return r ? r->completionTime : nullptr;
+        case ProcessColumn::TURNAROUND_TIME:
+        default:
+            return r ? r->turnaroundTime : nullptr;
+    }
+}
+
+long long ProcessTable::sumColumn(ProcessColumn column, ProcessSlot first, ProcessSlot last) const
+{
+    long long total = 0;
+    for (ProcessSlot begin = first; begin < last; )
+    {
+        size_t chunk = begin >> CHUNK_SHIFT;
+        ProcessSlot end = min<ProcessSlot>(last, static_cast<ProcessSlot>((chunk + 1) << CHUNK_SHIFT));
+        const SimTime* data = columnData(column, chunk);
+        if (data)
+        {
+            total += SimdKernels::sum(data + offset(begin), end - begin);
+        }
+        begin = end;
+    }
+    return total;
+}
+
+template <bool Largest>
+ProcessSlot ProcessTable::argColumn(ProcessColumn column, ProcessSlot first, ProcessSlot last) const
+{
+    ProcessSlot best = NO_PROCESS;
+    SimTime bestValue = 0;
+    for (ProcessSlot begin = first; begin < last; )
+    {
+        size_t chunk = begin >> CHUNK_SHIFT;
+        ProcessSlot end = min<ProcessSlot>(last, static_cast<ProcessSlot>((chunk + 1) << CHUNK_SHIFT));
+        const SimTime* data = columnData(column, chunk);
+
+        // A chunk without report storage is all zeros, so its first slot wins it
+        ProcessSlot candidate = begin;
+        SimTime value = 0;
+        if (data)
+        {
+            size_t length = end - begin;
+            size_t index = Largest ? SimdKernels::argMax(data + offset(begin), length)
+                                   : SimdKernels::argMin(data + offset(begin), length);
+            candidate = begin + static_cast<ProcessSlot>(index);
+            value = data[offset(candidate)];
+        }
+        if (best == NO_PROCESS || (Largest ? value > bestValue : value < bestValue))
+        {
+            best = candidate;
+            bestValue = value;
+        }
+        begin = end;
+    }
+    return best;
+}
+
+ProcessSlot ProcessTable::argMinColumn(ProcessColumn column, ProcessSlot first, ProcessSlot last) const
+{
+    return argColumn<false>(column, first, last);
+}
+
+ProcessSlot ProcessTable::argMaxColumn(ProcessColumn column, ProcessSlot first, ProcessSlot last) const
+{
+    return argColumn<true>(column, first, last);
+}
+
+SimTime ProcessTable::getWaitTimeAt(ProcessSlot s, SimTime currentTime) const
+{
+    const HotChunk& c = hotChunk(s);
+    size_t i = offset(s);
+    if (c.state[i] == ProcessState::READY)
+    {
+        return c.waitTime[i] + (currentTime - c.readySince[i]);
+    }
+    return c.waitTime[i];
+}
+
+void ProcessTable::execute(ProcessSlot s, SimTime timeSlice, SimTime currentTime)
+{
+    HotChunk& c = hotChunk(s);
+    size_t i = offset(s);
+    if (c.responseTime[i] < 0)
+    {
+        c.responseTime[i] = currentTime - getArrivalTime(s);
+    }
+
+    c.state[i] = ProcessState::RUNNING;
+    c.lastRunTime[i] = currentTime;
+
+    SimTime executionTime = min(timeSlice, c.remainingTime[i]);
+    c.remainingTime[i] -= executionTime;
+
+    if (c.remainingTime[i] <= 0)
+    {
+        c.state[i] = ProcessState::TERMINATED;
+    }
+}
+
+void ProcessTable::markReady(ProcessSlot s, SimTime currentTime)
+{
+    HotChunk& c = hotChunk(s);
+    size_t i = offset(s);
+    c.state[i] = ProcessState::READY;
+    c.readySince[i] = currentTime;
+}
+
+void ProcessTable::accrueWaitTime(ProcessSlot s, SimTime currentTime)
+{
+    HotChunk& c = hotChunk(s);
+    size_t i = offset(s);
+    if (c.state[i] == ProcessState::READY)
+    {
+        c.waitTime[i] += currentTime - c.readySince[i];
+        c.readySince[i] = currentTime;
+    }
+}
+
+void ProcessTable::calculateMetrics(ProcessSlot s, SimTime currentTime)
+{
+    HotChunk& c = hotChunk(s);
+    size_t i = offset(s);
+    if (c.state[i] == ProcessState::TERMINATED)
+    {
+        ReportChunk& r = reportChunk(s);
+        if (r.completionTime[i] == 0)
+        {
+            r.completionTime[i] = currentTime;
+        }
+        r.turnaroundTime[i] = r.completionTime[i] - getArrivalTime(s);
+        c.waitTime[i] = r.turnaroundTime[i] - getBurstTime(s);
+    }
+}
+
+void ProcessTable::setBurst(ProcessSlot s, SimTime burst)
+{
+    SimTime used = getCpuTimeUsed(s);
+    staticChunk(s).burstTime[offset(s)] = burst;
+    hotChunk(s).remainingTime[offset(s)] = burst - used;
+}
+
+string ProcessTable::toString(ProcessSlot s) const
+{
+    stringstream ss;
+    ss << "P" << setw(2) << setfill('0') << getPid(s)
+       << " [Queue:" << getPriority(s)
+       << " Arr:" << setw(3) << getArrivalTime(s)
+       << " Burst:" << setw(3) << getBurstTime(s)
+       << " Rem:" << setw(3) << getRemainingTime(s)
+       << " Wait:" << setw(3) << getWaitTime(s) << "]";
+    return ss.str();
+}
+
+int ProcessView::getPid() const { return table->getPid(slot); }
+int ProcessView::getPriority() const { return table->getPriority(slot); }
+SimTime ProcessView::getArrivalTime() const { return table->getArrivalTime(slot); }
+SimTime ProcessView::getBurstTime() const { return table->getBurstTime(slot); }
+SimTime ProcessView::getRemainingTime() const { return table->getRemainingTime(slot); }
+SimTime ProcessView::getCpuTimeUsed() const { return table->getCpuTimeUsed(slot); }
+SimTime ProcessView::getLastRunTime() const { return table->getLastRunTime(slot); }
+SimTime ProcessView::getQueueEnterTime() const { return table->getQueueEnterTime(slot); }
+SimTime ProcessView::getReadySince() const { return table->getReadySince(slot); }
+SimTime ProcessView::getWaitTime() const { return table->getWaitTime(slot); }
+SimTime ProcessView::getWaitTimeAt(SimTime currentTime) const { return table->getWaitTimeAt(slot, currentTime); }
+SimTime ProcessView::getTurnaroundTime() const { return table->getTurnaroundTime(slot); }
+SimTime ProcessView::getResponseTime() const { return table->getResponseTime(slot); }
+SimTime ProcessView::getCompletionTime() const { return table->getCompletionTime(slot); }
+ProcessState ProcessView::getState() const { return table->getState(slot); }
+bool ProcessView::isFirstRun() const { return table->isFirstRun(slot); }
+string ProcessView::toString() const { return table->toString(slot); }
@@ -1,53 +1,355 @@
 #include "Queue.h"
 #include <algorithm>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 using namespace std;
 
-ProcessQueue::ProcessQueue(int level, int quantum)
-    : queueLevel(level), timeQuantum(quantum) {}
+ProcessQueue::ProcessQueue(int level, SimTime quantum, QueueOrder order)
+    : head(NO_PROCESS), tail(NO_PROCESS), count(0), queueLevel(level), timeQuantum(quantum),
+      order(order), enqueueCounter(0), table(nullptr), readyMask(nullptr) {}
 
-void ProcessQueue::enqueue(shared_ptr<Process> process) 
+void ProcessQueue::bindReadyMask(uint64_t* mask)
 {
-    if (process) 
+    readyMask = mask;
+    updateReadyBit();
+}
+
+bool ProcessQueue::before(ProcessSlot a, ProcessSlot b) const
+{
+    switch (order)
     {
-        process->setPriority(queueLevel);
-        process->setState(ProcessState::READY);
-        queue.push_back(process);
+        case QueueOrder::SHORTEST_REMAINING_FIRST:
+            return ShortestRemainingOrder::before(*table, a, b);
+        case QueueOrder::LONGEST_WAIT_FIRST:
+            return LongestWaitOrder::before(*table, a, b);
+        case QueueOrder::FIFO:
+        default:
+            return FifoOrder::before(*table, a, b);
     }
 }
 
-shared_ptr<Process> ProcessQueue::dequeue() 
+bool ProcessQueue::listedBefore(ProcessSlot a, ProcessSlot b) const
 {
-    if (queue.empty()) 
+    // Aging keeps the queue listed by arrival even though it serves by wait;
+    // processes that arrived together stay in the order they were enqueued
+    if (order == QueueOrder::LONGEST_WAIT_FIRST)
     {
-        return nullptr;
+        if (table->getArrivalTime(a) != table->getArrivalTime(b))
+        {
+            return table->getArrivalTime(a) < table->getArrivalTime(b);
+        }
+        return table->getQueueSeq(a) < table->getQueueSeq(b);
     }
-    
-    auto process = queue.front();
-    queue.pop_front();
-    return process;
+    return before(a, b);
 }
 
-shared_ptr<Process> ProcessQueue::peek() const 
+ProcessSlot ProcessQueue::removeAt(size_t position)
 {
-    if (queue.empty()) 
+    switch (order)
     {
-        return nullptr;
+        case QueueOrder::SHORTEST_REMAINING_FIRST:
+            return removeAt<ShortestRemainingOrder>(position);
+        case QueueOrder::LONGEST_WAIT_FIRST:
+            return removeAt<LongestWaitOrder>(position);
+        case QueueOrder::FIFO:
+        default:
+            return removeAt<FifoOrder>(position);
     }
-    return queue.front();
 }
 
-bool ProcessQueue::removeProcess(int pid) 
+void ProcessQueue::enqueue(ProcessSlot slot) 
+{
+    if (slot == NO_PROCESS) 
+    {
+        return;
+    }
+
+    switch (order)
+    {
+        case QueueOrder::SHORTEST_REMAINING_FIRST:
+            push<ShortestRemainingOrder>(slot);
+            break;
+        case QueueOrder::LONGEST_WAIT_FIRST:
+            push<LongestWaitOrder>(slot);
+            break;
+        case QueueOrder::FIFO:
+            push<FifoOrder>(slot);
+            break;
+    }
+}
+
+ProcessSlot ProcessQueue::dequeue() 
+{
+    switch (order)
+    {
+        case QueueOrder::SHORTEST_REMAINING_FIRST:
+            return pop<ShortestRemainingOrder>();
+        case QueueOrder::LONGEST_WAIT_FIRST:
+            return pop<LongestWaitOrder>();
+        case QueueOrder::FIFO:
+        default:
+            return pop<FifoOrder>();
+    }
+}
+
+ProcessSlot ProcessQueue::peek() const 
+{
+    if (count == 0) 
+    {
+        return NO_PROCESS;
+    }
+    return (order != QueueOrder::FIFO) ? heap.front() : head;
+}
+
+ProcessQueue::Range ProcessQueue::getProcesses() const
+{
+    if (order != QueueOrder::FIFO)
+    {
+        return Range(table, SlotIterator(table, &heap, 0, NO_PROCESS),
+                     SlotIterator(table, &heap, heap.size(), NO_PROCESS), count);
+    }
+    return Range(table, SlotIterator(table, nullptr, 0, head),
+                 SlotIterator(table, nullptr, 0, NO_PROCESS), count);
+}
+
+vector<ProcessSlot> ProcessQueue::drain()
 {
-    auto it = find_if(queue.begin(), queue.end(),
-        [pid](const shared_ptr<Process>& p) 
+    vector<ProcessSlot> slots;
+    slots.reserve(count);
+
+    if (order != QueueOrder::FIFO)
+    {
+        slots.assign(heap.begin(), heap.end());
+        sort(slots.begin(), slots.end(),
+            [this](ProcessSlot a, ProcessSlot b)
+            {
+                return listedBefore(a, b);
+            });
+        for (ProcessSlot slot : slots)
         {
-            return p->getPid() == pid;
-        });
-    
-    if (it != queue.end()) 
+            table->setQueueSlot(slot, -1);
+        }
+    }
+    else
+    {
+        for (ProcessSlot slot = head; slot != NO_PROCESS; )
+        {
+            ProcessSlot next = table->getQueueNext(slot);
+            table->unlink(slot);
+            slots.push_back(slot);
+            slot = next;
+        }
+    }
+
+    for (ProcessSlot slot : slots)
+    {
+        table->setPriority(slot, queueLevel);
+    }
+    clear();
+    return slots;
+}
+
+void ProcessQueue::splice(ProcessQueue& other)
+{
+    if (&other == this || other.count == 0)
+    {
+        return;
+    }
+
+    if (order != QueueOrder::FIFO || other.order != QueueOrder::FIFO)
+    {
+        for (ProcessSlot slot : other.drain())
+        {
+            enqueue(slot);
+        }
+        return;
+    }
+
+    // Link other's list onto our tail
+    if (tail == NO_PROCESS)
+    {
+        head = other.head;
+    }
+    else
+    {
+        table->setQueueNext(tail, other.head);
+        table->setQueuePrev(other.head, tail);
+    }
+    tail = other.tail;
+    count += other.count;
+
+    other.clear();
+    updateReadyBit();
+}
+
+void ProcessQueue::setOrder(QueueOrder newOrder)
+{
+    if (newOrder == order)
+    {
+        return;
+    }
+
+    // Re-insert in the current queue order so that ties keep it
+    auto slots = drain();
+    order = newOrder;
+    for (ProcessSlot slot : slots)
+    {
+        enqueue(slot);
+    }
+}
+
+bool ProcessQueue::removeProcess(int pid) 
+{
+    // A queued process's priority names its level, so with one queue per
+    // level and table a hit needs no walk; the scan covers other numberings
+    ProcessSlot slot = table->findPid(pid);
+    if (slot != NO_PROCESS && table->getPriority(slot) == queueLevel && removeSlot(slot))
     {
-        queue.erase(it);
         return true;
     }
+
+    for (const auto& process : getProcesses())
+    {
+        if (process->getPid() == pid)
+        {
+            return removeSlot(process->getSlot());
+        }
+    }
     return false;
 }
+
+void ProcessQueue::rekey(ProcessSlot slot)
+{
+    int position = table->getQueueSlot(slot);
+    if (order == QueueOrder::FIFO || position < 0 ||
+        static_cast<size_t>(position) >= heap.size() || heap[position] != slot)
+    {
+        return;
+    }
+
+    switch (order)
+    {
+        case QueueOrder::SHORTEST_REMAINING_FIRST:
+            siftDown<ShortestRemainingOrder>(position);
+            siftUp<ShortestRemainingOrder>(table->getQueueSlot(slot));
+            break;
+        case QueueOrder::LONGEST_WAIT_FIRST:
+            siftDown<LongestWaitOrder>(position);
+            siftUp<LongestWaitOrder>(table->getQueueSlot(slot));
+            break;
+        case QueueOrder::FIFO:
+            break;
+    }
+}
+
+bool ProcessQueue::removeSlot(ProcessSlot slot)
+{
+    if (slot == NO_PROCESS || count == 0)
+    {
+        return false;
+    }
+
+    if (order != QueueOrder::FIFO)
+    {
+        // Ordered queues know where each process sits, no search needed
+        int position = table->getQueueSlot(slot);
+        if (position < 0 || static_cast<size_t>(position) >= heap.size() || heap[position] != slot)
+        {
+            return false;
+        }
+        removeAt(position);
+    }
+    else
+    {
+        if (!table->isLinked(slot))
+        {
+            return false;
+        }
+        unlink(slot);
+    }
+    count--;
+    updateReadyBit();
+    table->setPriority(slot, queueLevel);
+    return true;
+}
+
+void ProcessQueue::clear()
+{
+    head = NO_PROCESS;
+    tail = NO_PROCESS;
+    heap.clear();
+    count = 0;
+    updateReadyBit();
+}
+
+MultilevelQueue::MultilevelQueue() : nonEmptyMask(0) {}
+
+MultilevelQueue::MultilevelQueue(const vector<SimTime>& quantums) : nonEmptyMask(0)
+{
+    levels.reserve(quantums.size());
+    for (size_t i = 0; i < quantums.size(); i++)
+    {
+        levels.emplace_back(static_cast<int>(i), quantums[i]);
+    }
+    bindLevels();
+}
+
+MultilevelQueue::MultilevelQueue(const MultilevelQueue& other)
+    : levels(other.levels), nonEmptyMask(other.nonEmptyMask)
+{
+    bindLevels();
+}
+
+MultilevelQueue& MultilevelQueue::operator=(const MultilevelQueue& other)
+{
+    if (this != &other)
+    {
+        levels = other.levels;
+        nonEmptyMask = other.nonEmptyMask;
+        bindLevels();
+    }
+    return *this;
+}
+
+void MultilevelQueue::bindLevels()
+{
+    for (auto& level : levels)
+    {
+        level.bindReadyMask(&nonEmptyMask);
+    }
+}
+
+void MultilevelQueue::bindTable(ProcessTable* table)
+{
+    for (auto& level : levels)
+    {
+        level.bindTable(table);
+    }
+}
+
+bool MultilevelQueue::moveProcess(ProcessSlot slot, int fromLevel, int toLevel)
+{
+    if (!levels[fromLevel].removeSlot(slot))
+    {
+        return false;
+    }
+    levels[toLevel].enqueue(slot);
+    return true;
+}
+
+int MultilevelQueue::highestReadyLevel() const
+{
+    if (nonEmptyMask == 0)
+    {
+        return -1;
+    }
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, nonEmptyMask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(nonEmptyMask);
+#endif
+}
@@ -0,0 +1,411 @@
+#include "ReplayLog.h"
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+using namespace std;
+
+namespace
+{
+    // Version 2 appends the tick length to the header; version 1 logs
+    // were recorded in milliseconds
+    const char MAGIC[8] = {'M', 'L', 'F', 'Q', 'R', 'P', 'L', '2'};
+    const char MAGIC_V1[8] = {'M', 'L', 'F', 'Q', 'R', 'P', 'L', '1'};
+
+    void putVarint(vector<uint8_t>& out, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    // Zigzag keeps small negative values short
+    void putSigned(vector<uint8_t>& out, long long value)
+    {
+        putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void putFixed64(vector<uint8_t>& out, uint64_t value)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    // Bounds-checked reader over a serialized log
+    class Reader
+    {
+    private:
+        const vector<uint8_t>& bytes;
+        size_t pos;
+
+    public:
+        explicit Reader(const vector<uint8_t>& b) : bytes(b), pos(0) {}
+
+        bool atEnd() const { return pos == bytes.size(); }
+
+        bool byte(uint8_t& value)
+        {
+            if (pos >= bytes.size())
+            {
+                return false;
+            }
+            value = bytes[pos++];
+            return true;
+        }
+
+        bool varint(uint64_t& value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                uint8_t b;
+                if (!byte(b))
+                {
+                    return false;
+                }
+                value |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if (!(b & 0x80))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool signedInt(long long& value)
+        {
+            uint64_t raw;
+            if (!varint(raw))
+            {
+                return false;
+            }
+            value = static_cast<long long>((raw >> 1) ^ (~(raw & 1) + 1));
+            return true;
+        }
+
+        bool fixed64(uint64_t& value)
+        {
+            value = 0;
+            for (int i = 0; i < 8; i++)
+            {
+                uint8_t b;
+                if (!byte(b))
+                {
+                    return false;
+                }
+                value |= static_cast<uint64_t>(b) << (8 * i);
+            }
+            return true;
+        }
+    };
+
+    bool readInt(Reader& in, int& value)
+    {
+        long long wide;
+        if (!in.signedInt(wide) || wide < INT32_MIN || wide > INT32_MAX)
+        {
+            return false;
+        }
+        value = static_cast<int>(wide);
+        return true;
+    }
+
+    // base += delta, failing instead of wrapping
+    bool addTime(SimTime& base, long long delta)
+    {
+        if ((delta > 0 && base > SIM_TIME_MAX - delta) || (delta < 0 && base < LLONG_MIN - delta))
+        {
+            return false;
+        }
+        base += delta;
+        return true;
+    }
+}
+
+ReplayLog::ReplayLog()
+    : initialAlgorithm(LastQueueAlgorithm::ROUND_ROBIN), finished(false), logComplete(true), recordedHash(0) {}
+
+void ReplayLog::begin(const SchedulerConfig& cfg, LastQueueAlgorithm algorithm)
+{
+    config = cfg;
+    initialAlgorithm = algorithm;
+    events.clear();
+    finished = false;
+    logComplete = true;
+    recordedHash = 0;
+}
+
+void ReplayLog::reopen()
+{
+    // Inputs after finish() move the end marker past them
+    if (finished)
+    {
+        events.pop_back();
+        finished = false;
+    }
+}
+
+void ReplayLog::record(ReplayEvent::Type type, SimTime time, SimTime a, SimTime b)
+{
+    reopen();
+    events.push_back(ReplayEvent{type, time, a, b});
+}
+
+bool ReplayLog::finish(const MLFQScheduler& scheduler, string& errorMsg)
+{
+    if (!logComplete)
+    {
+        errorMsg = "Recording cannot be verified: the execution log was off during a run, or the scheduler was restored";
+        return false;
+    }
+    reopen();
+    recordedHash = hashExecutionLog(scheduler);
+    events.push_back(ReplayEvent{ReplayEvent::END, scheduler.getCurrentTime(), 0, 0});
+    finished = true;
+    return true;
+}
+
+uint64_t ReplayLog::hashExecutionLog(const MLFQScheduler& scheduler)
+{
+    uint64_t hash = 1469598103934665603ULL;
+    // Values that fit 32 bits hash as four bytes, as before SimTime was
+    // 64-bit, so logs recorded then still verify; wider ones add four more
+    auto mix = [&hash](SimTime value)
+    {
+        uint64_t bits = static_cast<uint64_t>(value);
+        int bytes = (value >= INT32_MIN && value <= INT32_MAX) ? 4 : 8;
+        for (int i = 0; i < bytes; i++)
+        {
+            hash ^= (bits >> (8 * i)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    };
+    for (const auto& span : scheduler.getExecutionLog())
+    {
+        mix(span.pid);
+        mix(span.startTime);
+        mix(span.endTime);
+        mix(span.queueLevel);
+    }
+    return hash;
+}
+
+ReplayResult ReplayLog::replay() const
+{
+    MLFQScheduler scheduler(config);
+    return replay(scheduler);
+}
+
+ReplayResult ReplayLog::replay(MLFQScheduler& scheduler) const
+{
+    // Inputs were applied between ticks, so running the clock up to each
+    // event's time and then applying it reproduces the original schedule
+    scheduler.setExecutionLogging(true);
+    scheduler.setLastQueueAlgorithm(initialAlgorithm);
+
+    for (const auto& event : events)
+    {
+        scheduler.runUntil(event.time);
+        switch (event.type)
+        {
+            case ReplayEvent::ADD_PROCESS:
+                scheduler.addProcess(event.a, event.b);
+                break;
+            case ReplayEvent::SET_ALGORITHM:
+                scheduler.setLastQueueAlgorithm(static_cast<LastQueueAlgorithm>(event.a));
+                break;
+            case ReplayEvent::SET_BOOST_INTERVAL:
+                scheduler.setBoostInterval(event.a);
+                break;
+            case ReplayEvent::CANCEL_PROCESS:
+                scheduler.cancelProcess(static_cast<int>(event.a));
+                break;
+            case ReplayEvent::SET_BURST:
+                scheduler.setBurst(static_cast<int>(event.a), event.b);
+                break;
+            case ReplayEvent::END:
+                break;
+        }
+    }
+
+    ReplayResult result;
+    result.hash = hashExecutionLog(scheduler);
+    result.endTime = scheduler.getCurrentTime();
+    result.matches = finished && result.hash == recordedHash;
+    return result;
+}
+
+vector<uint8_t> ReplayLog::serialize() const
+{
+    vector<uint8_t> out(MAGIC, MAGIC + sizeof(MAGIC));
+    out.reserve(sizeof(MAGIC) + 32 + events.size() * 4);
+
+    putSigned(out, config.numQueues);
+    putSigned(out, config.boostInterval);
+    putSigned(out, config.baseQuantum);
+    uint64_t multiplierBits;
+    memcpy(&multiplierBits, &config.quantumMultiplier, sizeof(multiplierBits));
+    putFixed64(out, multiplierBits);
+    putSigned(out, config.numCores);
+    putSigned(out, config.migrationPenalty);
+    out.push_back(static_cast<uint8_t>(initialAlgorithm));
+    putSigned(out, config.tickLength);
+
+    SimTime lastTime = 0;
+    for (const auto& event : events)
+    {
+        out.push_back(event.type);
+        putSigned(out, event.time - lastTime);
+        lastTime = event.time;
+        switch (event.type)
+        {
+            case ReplayEvent::ADD_PROCESS:
+                // Arrival relative to submission; negative for late submissions
+                putSigned(out, event.a - event.time);
+                putSigned(out, event.b);
+                break;
+            case ReplayEvent::SET_ALGORITHM:
+            case ReplayEvent::SET_BOOST_INTERVAL:
+            case ReplayEvent::CANCEL_PROCESS:
+                putSigned(out, event.a);
+                break;
+            case ReplayEvent::SET_BURST:
+                putSigned(out, event.a);
+                putSigned(out, event.b);
+                break;
+            case ReplayEvent::END:
+                putFixed64(out, recordedHash);
+                break;
+        }
+    }
+    return out;
+}
+
+bool ReplayLog::deserialize(const vector<uint8_t>& bytes, string& errorMsg)
+{
+    bool version1 = bytes.size() >= sizeof(MAGIC_V1) && memcmp(bytes.data(), MAGIC_V1, sizeof(MAGIC_V1)) == 0;
+    if (!version1 && (bytes.size() < sizeof(MAGIC) || memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0))
+    {
+        errorMsg = "Not a replay log";
+        return false;
+    }
+
+    vector<uint8_t> body(bytes.begin() + sizeof(MAGIC), bytes.end());
+    Reader in(body);
+
+    SchedulerConfig cfg;
+    uint64_t multiplierBits;
+    uint8_t algorithm;
+    if (!readInt(in, cfg.numQueues) || !in.signedInt(cfg.boostInterval) ||
+        !in.signedInt(cfg.baseQuantum) || !in.fixed64(multiplierBits) ||
+        !readInt(in, cfg.numCores) || !in.signedInt(cfg.migrationPenalty) ||
+        !in.byte(algorithm) || algorithm > static_cast<uint8_t>(LastQueueAlgorithm::PRIORITY_SCHEDULING) ||
+        (!version1 && (!in.signedInt(cfg.tickLength) || cfg.tickLength < 1)))
+    {
+        errorMsg = "Truncated or corrupt replay log header";
+        return false;
+    }
+    memcpy(&cfg.quantumMultiplier, &multiplierBits, sizeof(multiplierBits));
+
+    vector<ReplayEvent> decoded;
+    bool ended = false;
+    uint64_t hash = 0;
+    SimTime time = 0;
+    while (!in.atEnd() && !ended)
+    {
+        uint8_t type;
+        long long delta;
+        if (!in.byte(type) || !in.signedInt(delta))
+        {
+            errorMsg = "Truncated replay event";
+            return false;
+        }
+        if (!addTime(time, delta))
+        {
+            errorMsg = "Replay event time out of range";
+            return false;
+        }
+
+        ReplayEvent event{static_cast<ReplayEvent::Type>(type), time, 0, 0};
+        bool ok = true;
+        switch (type)
+        {
+            case ReplayEvent::ADD_PROCESS:
+            {
+                long long offset;
+                event.a = time;
+                ok = in.signedInt(offset) && in.signedInt(event.b) && addTime(event.a, offset);
+                break;
+            }
+            case ReplayEvent::SET_ALGORITHM:
+                ok = in.signedInt(event.a) && event.a >= 0 &&
+                     event.a <= static_cast<int>(LastQueueAlgorithm::PRIORITY_SCHEDULING);
+                break;
+            case ReplayEvent::SET_BOOST_INTERVAL:
+                ok = in.signedInt(event.a);
+                break;
+            case ReplayEvent::CANCEL_PROCESS:
+                ok = in.signedInt(event.a) && event.a > 0 && event.a <= INT_MAX;
+                break;
+            case ReplayEvent::SET_BURST:
+                ok = in.signedInt(event.a) && event.a > 0 && event.a <= INT_MAX && in.signedInt(event.b);
+                break;
+            case ReplayEvent::END:
+                ok = in.fixed64(hash);
+                ended = true;
+                break;
+            default:
+                errorMsg = "Unknown replay event type " + to_string(type);
+                return false;
+        }
+        if (!ok)
+        {
+            errorMsg = "Truncated or corrupt replay event";
+            return false;
+        }
+        decoded.push_back(event);
+    }
+
+    config = cfg;
+    initialAlgorithm = static_cast<LastQueueAlgorithm>(algorithm);
+    events.swap(decoded);
+    finished = ended;
+    logComplete = true;
+    recordedHash = hash;
+    return true;
+}
+
+bool ReplayLog::save(const string& path, string& errorMsg) const
+{
+    ofstream file(path, ios::binary);
+    if (!file.is_open())
+    {
+        errorMsg = "Could not create " + path;
+        return false;
+    }
+    vector<uint8_t> bytes = serialize();
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<streamsize>(bytes.size()));
+    if (!file)
+    {
+        errorMsg = "Could not write " + path;
+        return false;
+    }
+    return true;
+}
+
+bool ReplayLog::load(const string& path, string& errorMsg)
+{
+    ifstream file(path, ios::binary);
+    if (!file.is_open())
+    {
+        errorMsg = "Could not open " + path;
+        return false;
+    }
+    vector<uint8_t> bytes((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    return deserialize(bytes, errorMsg);
+}
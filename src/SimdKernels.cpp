@@ -0,0 +1,382 @@
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define SIMD_KERNELS_SSE2 1
+#include <immintrin.h>
+#endif
+
+// GCC and Clang build the AVX2 kernels with a per-function target, so the
+// rest of the program keeps the default instruction set; MSVC stays on SSE2
+#if defined(SIMD_KERNELS_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_KERNELS_AVX2 1
+#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define KERNEL_TARGET(isa)
+#endif
+using namespace std;
+
+namespace
+{
+    typedef long long (*SumKernel)(const int*, size_t);
+    typedef size_t (*ArgKernel)(const int*, size_t);
+    typedef long long (*WideSumKernel)(const long long*, size_t);
+    typedef size_t (*WideArgKernel)(const long long*, size_t);
+
+    // Vector lanes hold 32-bit indices, so long arrays are scanned in blocks
+    const size_t BLOCK = size_t(1) << 30;
+
+    template <bool Largest, class T>
+    bool better(T candidate, T best)
+    {
+        return Largest ? candidate > best : candidate < best;
+    }
+
+    template <class T>
+    long long sumScalar(const T* values, size_t count)
+    {
+        long long total = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            total += values[i];
+        }
+        return total;
+    }
+
+    template <bool Largest, class T>
+    size_t argScalar(const T* values, size_t count)
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < count; i++)
+        {
+            if (better<Largest>(values[i], values[best]))
+            {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // Combine per-lane winners, then finish the tail that did not fill a vector.
+    // Each lane only replaces its winner on a strict improvement, so it holds
+    // the first index of its own best value; ties across lanes take the lower index
+    template <bool Largest, size_t Lanes, class T, class Index>
+    size_t finishArg(const T* values, size_t count, size_t scanned,
+                     const T* laneValues, const Index* laneIndex)
+    {
+        size_t lane = 0;
+        for (size_t l = 1; l < Lanes; l++)
+        {
+            if (better<Largest>(laneValues[l], laneValues[lane]) ||
+                (laneValues[l] == laneValues[lane] && laneIndex[l] < laneIndex[lane]))
+            {
+                lane = l;
+            }
+        }
+        size_t best = static_cast<size_t>(laneIndex[lane]);
+        for (size_t i = scanned; i < count; i++)
+        {
+            if (better<Largest>(values[i], values[best]))
+            {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+#ifdef SIMD_KERNELS_SSE2
+    KERNEL_TARGET("sse2")
+    long long sumSse2(const int* values, size_t count)
+    {
+        __m128i acc = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            // Sign-extend to 64 bits before adding
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+            __m128i sign = _mm_srai_epi32(x, 31);
+            acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(x, sign));
+            acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(x, sign));
+        }
+        long long lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        return lanes[0] + lanes[1] + sumScalar<int>(values + i, count - i);
+    }
+
+    template <bool Largest>
+    KERNEL_TARGET("sse2")
+    size_t argSse2(const int* values, size_t count)
+    {
+        if (count < 8)
+        {
+            return argScalar<Largest, int>(values, count);
+        }
+        __m128i bestValue = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+        __m128i bestIndex = _mm_setr_epi32(0, 1, 2, 3);
+        __m128i index = bestIndex;
+        const __m128i step = _mm_set1_epi32(4);
+        size_t i = 4;
+        for (; i + 4 <= count; i += 4)
+        {
+            index = _mm_add_epi32(index, step);
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+            __m128i take = Largest ? _mm_cmpgt_epi32(x, bestValue) : _mm_cmplt_epi32(x, bestValue);
+            // No blend before SSE4.1
+            bestValue = _mm_or_si128(_mm_and_si128(take, x), _mm_andnot_si128(take, bestValue));
+            bestIndex = _mm_or_si128(_mm_and_si128(take, index), _mm_andnot_si128(take, bestIndex));
+        }
+        int laneValues[4];
+        int laneIndex[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(laneValues), bestValue);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(laneIndex), bestIndex);
+        return finishArg<Largest, 4>(values, count, i, laneValues, laneIndex);
+    }
+
+    KERNEL_TARGET("sse2")
+    long long sumWideSse2(const long long* values, size_t count)
+    {
+        __m128i acc = _mm_setzero_si128();
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            acc = _mm_add_epi64(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)));
+        }
+        long long lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+        return lanes[0] + lanes[1] + sumScalar<long long>(values + i, count - i);
+    }
+#endif
+
+#ifdef SIMD_KERNELS_AVX2
+    KERNEL_TARGET("avx2")
+    long long sumAvx2(const int* values, size_t count)
+    {
+        __m256i low = _mm256_setzero_si256();
+        __m256i high = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i + 4));
+            low = _mm256_add_epi64(low, _mm256_cvtepi32_epi64(a));
+            high = _mm256_add_epi64(high, _mm256_cvtepi32_epi64(b));
+        }
+        long long lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(low, high));
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumScalar<int>(values + i, count - i);
+    }
+
+    template <bool Largest>
+    KERNEL_TARGET("avx2")
+    size_t argAvx2(const int* values, size_t count)
+    {
+        if (count < 16)
+        {
+            return argScalar<Largest, int>(values, count);
+        }
+        __m256i bestValue = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+        __m256i bestIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i index = bestIndex;
+        const __m256i step = _mm256_set1_epi32(8);
+        size_t i = 8;
+        for (; i + 8 <= count; i += 8)
+        {
+            index = _mm256_add_epi32(index, step);
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            __m256i take = Largest ? _mm256_cmpgt_epi32(x, bestValue) : _mm256_cmpgt_epi32(bestValue, x);
+            bestValue = _mm256_blendv_epi8(bestValue, x, take);
+            bestIndex = _mm256_blendv_epi8(bestIndex, index, take);
+        }
+        int laneValues[8];
+        int laneIndex[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneValues), bestValue);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneIndex), bestIndex);
+        return finishArg<Largest, 8>(values, count, i, laneValues, laneIndex);
+    }
+
+    KERNEL_TARGET("avx2")
+    long long sumWideAvx2(const long long* values, size_t count)
+    {
+        __m256i low = _mm256_setzero_si256();
+        __m256i high = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            low = _mm256_add_epi64(low, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+            high = _mm256_add_epi64(high, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + 4)));
+        }
+        long long lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(low, high));
+        return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumScalar<long long>(values + i, count - i);
+    }
+
+    // 64-bit lanes need the AVX2 compare; indices fit the lanes, so no blocking
+    template <bool Largest>
+    KERNEL_TARGET("avx2")
+    size_t argWideAvx2(const long long* values, size_t count)
+    {
+        if (count < 8)
+        {
+            return argScalar<Largest, long long>(values, count);
+        }
+        __m256i bestValue = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+        __m256i bestIndex = _mm256_setr_epi64x(0, 1, 2, 3);
+        __m256i index = bestIndex;
+        const __m256i step = _mm256_set1_epi64x(4);
+        size_t i = 4;
+        for (; i + 4 <= count; i += 4)
+        {
+            index = _mm256_add_epi64(index, step);
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            __m256i take = Largest ? _mm256_cmpgt_epi64(x, bestValue) : _mm256_cmpgt_epi64(bestValue, x);
+            bestValue = _mm256_blendv_epi8(bestValue, x, take);
+            bestIndex = _mm256_blendv_epi8(bestIndex, index, take);
+        }
+        long long laneValues[4];
+        long long laneIndex[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneValues), bestValue);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneIndex), bestIndex);
+        return finishArg<Largest, 4>(values, count, i, laneValues, laneIndex);
+    }
+#endif
+
+    struct Dispatch
+    {
+        SimdKernels::InstructionSet set;
+        SumKernel sum;
+        ArgKernel argMin;
+        ArgKernel argMax;
+        WideSumKernel wideSum;
+        WideArgKernel wideArgMin;
+        WideArgKernel wideArgMax;
+    };
+
+    Dispatch kernelsFor(SimdKernels::InstructionSet set)
+    {
+        switch (set)
+        {
+#ifdef SIMD_KERNELS_AVX2
+            case SimdKernels::InstructionSet::AVX2:
+                return Dispatch{set, sumAvx2, argAvx2<false>, argAvx2<true>,
+                                sumWideAvx2, argWideAvx2<false>, argWideAvx2<true>};
+#endif
+#ifdef SIMD_KERNELS_SSE2
+            case SimdKernels::InstructionSet::SSE2:
+                // SSE2 has no 64-bit compare, so wide argmin/argmax stay scalar
+                return Dispatch{set, sumSse2, argSse2<false>, argSse2<true>,
+                                sumWideSse2, argScalar<false, long long>, argScalar<true, long long>};
+#endif
+            default:
+                return Dispatch{SimdKernels::InstructionSet::SCALAR, sumScalar<int>, argScalar<false, int>, argScalar<true, int>,
+                                sumScalar<long long>, argScalar<false, long long>, argScalar<true, long long>};
+        }
+    }
+
+    // Chosen once, on first use
+    Dispatch& kernels()
+    {
+        static Dispatch current = kernelsFor(SimdKernels::detected());
+        return current;
+    }
+
+    template <bool Largest>
+    size_t argBlocks(ArgKernel kernel, const int* values, size_t count)
+    {
+        if (count == 0)
+        {
+            return count;
+        }
+        size_t best = kernel(values, min(count, BLOCK));
+        for (size_t start = BLOCK; start < count; start += BLOCK)
+        {
+            size_t candidate = start + kernel(values + start, min(BLOCK, count - start));
+            if (better<Largest>(values[candidate], values[best]))
+            {
+                best = candidate;
+            }
+        }
+        return best;
+    }
+}
+
+namespace SimdKernels
+{
+    long long sum(const int* values, size_t count)
+    {
+        return kernels().sum(values, count);
+    }
+
+    size_t argMin(const int* values, size_t count)
+    {
+        return argBlocks<false>(kernels().argMin, values, count);
+    }
+
+    size_t argMax(const int* values, size_t count)
+    {
+        return argBlocks<true>(kernels().argMax, values, count);
+    }
+
+    long long sum(const long long* values, size_t count)
+    {
+        return kernels().wideSum(values, count);
+    }
+
+    size_t argMin(const long long* values, size_t count)
+    {
+        return count == 0 ? count : kernels().wideArgMin(values, count);
+    }
+
+    size_t argMax(const long long* values, size_t count)
+    {
+        return count == 0 ? count : kernels().wideArgMax(values, count);
+    }
+
+    InstructionSet detected()
+    {
+#if defined(SIMD_KERNELS_AVX2)
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return InstructionSet::AVX2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return InstructionSet::SSE2;
+        }
+        return InstructionSet::SCALAR;
+#elif defined(SIMD_KERNELS_SSE2)
+        return InstructionSet::SSE2;   // Part of x86-64
+#else
+        return InstructionSet::SCALAR;
+#endif
+    }
+
+    InstructionSet active()
+    {
+        return kernels().set;
+    }
+
+    bool select(InstructionSet set)
+    {
+        if (set > detected() || kernelsFor(set).set != set)
+        {
+            return false;
+        }
+        kernels() = kernelsFor(set);
+        return true;
+    }
+
+    const char* name(InstructionSet set)
+    {
+        switch (set)
+        {
+            case InstructionSet::AVX2:
+                return "AVX2";
+            case InstructionSet::SSE2:
+                return "SSE2";
+            case InstructionSet::SCALAR:
+            default:
+                return "scalar";
+        }
+    }
+}
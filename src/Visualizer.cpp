@@ -25,7 +25,7 @@ string Visualizer::getStateSymbol(ProcessState state) const
     }
 }
 
-string Visualizer::getProgressBar(int current, int total, int width) const
+string Visualizer::getProgressBar(SimTime current, SimTime total, int width) const
 {
     return TerminalUI::progressBar(current, total, width);
 }
@@ -104,7 +104,7 @@ void Visualizer::displayCurrentProcess() const {
         cout << " " << pInfo.str() << endl;
         
         // Progress bar
-        int progress = current->getBurstTime() - current->getRemainingTime();
+        SimTime progress = current->getBurstTime() - current->getRemainingTime();
         float percentage = 100.0f * progress / current->getBurstTime();
         
         cout << " Progress: " << getProgressBar(progress, current->getBurstTime(), 40) 
@@ -129,7 +129,17 @@ void Visualizer::displayStats() const {
         {"Avg Response Time", to_string(stats.avgResponseTime).substr(0, 5) + " ms"},
         {"CPU Utilization", to_string(stats.cpuUtilization).substr(0, 5) + "%"}
     };
-    
+
+    CompletionReport report = scheduler.getCompletionReport();
+    if (report.maxWaitPid >= 0)
+    {
+        statsList.push_back({"Longest Wait", "P" + to_string(report.maxWaitPid) + " (" +
+                             to_string(report.maxWaitTime) + " ms)"});
+        statsList.push_back({"Turnaround Range", to_string(report.minTurnaroundTime) + "-" +
+                             to_string(report.maxTurnaroundTime) + " ms (P" +
+                             to_string(report.maxTurnaroundPid) + " slowest)"});
+    }
+
     for (const auto& stat : statsList) {
         cout << " " << left << setw(30) << stat.first 
                   << ": " << stat.second << endl;
@@ -241,7 +251,7 @@ void Visualizer::displayProcessTable() const
             completion = "-";  // Show '-' for non-completed processes
         }
         
-        int completed = proc->getBurstTime() - proc->getRemainingTime();
+        SimTime completed = proc->getBurstTime() - proc->getRemainingTime();
         string progress = to_string(completed) + "/" + to_string(proc->getBurstTime());
         
         vector<string> row = 
@@ -5,6 +5,7 @@
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <unistd.h>
+#include <cstdlib>
 #include <cstring>
 using namespace std;
 
@@ -139,6 +140,36 @@ void WebServer::handleClient(int clientSocket) {
             response += "\r\n";
             response += content;
         }
+    } else if (request.find("GET /submit?") != string::npos) {
+        // Live job feed: /submit?arrival=A&burst=B. The server thread only
+        // ever calls submit(), the scheduler's one thread-safe entry point
+        SimTime arrival = 0;
+        SimTime burst = 0;
+        string line = request.substr(0, request.find("\r\n"));
+        size_t arrivalAt = line.find("arrival=");
+        size_t burstAt = line.find("burst=");
+        if (arrivalAt != string::npos)
+        {
+            arrival = atoll(line.c_str() + arrivalAt + 8);
+        }
+        if (burstAt != string::npos)
+        {
+            burst = atoll(line.c_str() + burstAt + 6);
+        }
+
+        string content;
+        if (burst > 0 && arrival >= 0) {
+            scheduler->submit(arrival, burst);
+            content = "{\"submitted\": true}";
+            response = "HTTP/1.1 200 OK\r\n";
+        } else {
+            content = "{\"submitted\": false, \"error\": \"need burst > 0 and arrival >= 0\"}";
+            response = "HTTP/1.1 400 Bad Request\r\n";
+        }
+        response += "Content-Type: application/json\r\n";
+        response += "Content-Length: " + to_string(content.length()) + "\r\n";
+        response += "\r\n";
+        response += content;
     } else {
         string content = "404 Not Found";
         response = "HTTP/1.1 404 Not Found\r\n";
@@ -1,4 +1,5 @@
 #include "MLFQScheduler.h"
+#include "ReplayLog.h"
 #include "Visualizer.h"
 #include "SchedulerConfig.h"
 #include "TerminalUI.h"
@@ -6,6 +7,7 @@
 #include <iostream>
 #include <fstream>
 #include <thread>
+#include <atomic>
 #include <chrono>
 #include <memory>  // For smart pointers
 #include <random>
@@ -13,6 +15,7 @@
 #include <algorithm>
 #include <ctime>
 #include <limits>
+#include <cstdlib>
 
 #ifdef FLTK_AVAILABLE
 #include "FLTKVisualizer.h"
@@ -38,6 +41,8 @@ void displayPresetMenu();
 void compareLastQueueAlgorithms();
 void createCustomProcesses(MLFQScheduler& scheduler);
 void generateRandomProcesses(MLFQScheduler& scheduler);
+int runReplayMode(const string& path);
+int runScaleMode(long long numProcesses, SimTime tickLength, const string& spillPath);
 
 void runInteractiveMode(MLFQScheduler& scheduler, Visualizer& viz)
 {
@@ -128,10 +133,7 @@ void runQuickMode(MLFQScheduler& scheduler, Visualizer& viz)
 
     auto startTime = chrono::high_resolution_clock::now();
 
-    while (!scheduler.isComplete())
-    {
-        scheduler.step();
-    }
+    scheduler.runToCompletion();
 
     auto endTime = chrono::high_resolution_clock::now();
     auto duration = chrono::duration_cast<chrono::milliseconds>(endTime - startTime);
@@ -224,7 +226,7 @@ void runComparisonMode()
         double avgTurnaround;
         double avgResponse;
         double cpuUtil;
-        int totalTime;
+        SimTime totalTime;
     };
 
     vector<AlgoResult> results;
@@ -251,10 +253,9 @@ void runComparisonMode()
             scheduler.addProcess(p.first, p.second);
         }
 
-        while (!scheduler.isComplete())
-        {
-            scheduler.step();
-        }
+        // Only the statistics are compared, so skip the Gantt log
+        scheduler.setExecutionLogging(false);
+        scheduler.runToCompletion();
 
         auto stats = scheduler.getStats();
         results.push_back
@@ -712,7 +713,7 @@ void compareLastQueueAlgorithms()
         double avgTurnaround;
         double avgResponse;
         double cpuUtil;
-        int totalTime;
+        SimTime totalTime;
     };
     
     vector<Result> results;
@@ -725,19 +726,20 @@ void compareLastQueueAlgorithms()
     
     string algoNames[] = {"Round Robin", "Shortest Job First", "Priority Scheduling"};
     
+    // Load the workload once; each algorithm runs on a copy-on-write fork
+    MLFQScheduler base(3, 100);
+    for (const auto& p : processes) {
+        base.addProcess(p.first, p.second);
+    }
+    // Only the statistics are compared, so skip the Gantt log
+    base.setExecutionLogging(false);
+    
     for (int i = 0; i < 3; i++) {
         cout << "Testing " << algoNames[i] << "...\n";
         
-        MLFQScheduler scheduler(3, 100);
+        MLFQScheduler scheduler = base.fork();
         scheduler.setLastQueueAlgorithm(algos[i]);
-        
-        for (const auto& p : processes) {
-            scheduler.addProcess(p.first, p.second);
-        }
-        
-        while (!scheduler.isComplete()) {
-            scheduler.step();
-        }
+        scheduler.runToCompletion();
         
         auto stats = scheduler.getStats();
         results.push_back({
@@ -784,14 +786,171 @@ void compareLastQueueAlgorithms()
     cin.get();
 }
 
-int main()
+int runReplayMode(const string& path)
 {
+    ReplayLog log;
+    string error;
+    if (!log.load(path, error))
+    {
+        cout << TerminalUI::Style::error("Replay failed: " + error) << "\n";
+        return 1;
+    }
+
+    cout << "\n" << TerminalUI::Style::header("=== Replay: " + path + " ===") << "\n";
+    log.getConfig().displayQuantums();
+
+    auto startTime = chrono::high_resolution_clock::now();
+    ReplayResult result = log.replay();
+    auto endTime = chrono::high_resolution_clock::now();
+    auto duration = chrono::duration_cast<chrono::milliseconds>(endTime - startTime);
+
+    cout << "  Events replayed: " << log.getEvents().size() << "\n";
+    cout << "  Simulated time:  " << log.getConfig().formatTicks(result.endTime) << " (" << duration.count() << " ms real time)\n";
+    cout << "  Log hash:        " << hex << setw(16) << setfill('0') << result.hash << dec << setfill(' ') << "\n";
+
+    if (!log.isFinished())
+    {
+        cout << TerminalUI::Style::warning("Recording was not finished; nothing to verify against") << "\n";
+        return 1;
+    }
+    if (!result.matches)
+    {
+        cout << TerminalUI::Style::error("MISMATCH: recorded hash was ") << hex << log.getRecordedHash() << dec << "\n";
+        return 1;
+    }
+    cout << TerminalUI::Style::success("Execution log matches the recording") << "\n";
+    return 0;
+}
+
+int runScaleMode(long long numProcesses, SimTime tickLength, const string& spillPath)
+{
+    SchedulerConfig config = ConfigurationManager::getScaleProfile(numProcesses, tickLength);
+    string error;
+    if (!config.validate(error))
+    {
+        cout << TerminalUI::Style::error("Scale run failed: " + error) << "\n";
+        return 1;
+    }
+
+    cout << "\n" << TerminalUI::Style::header("=== Scale Run: " + to_string(numProcesses) + " processes ===") << "\n";
+    cout << "  Queues: " << config.numQueues << ", base quantum " << config.formatTicks(config.baseQuantum)
+         << " x" << config.quantumMultiplier << ", boost every " << config.formatTicks(config.boostInterval)
+         << ", tick " << formatDuration(config.tickLength) << "\n";
+
+    // Fixed seed so runs are comparable; arrivals come unsorted, as in a
+    // trace merged from several machines, and loadWorkload() sorts them
+    mt19937_64 gen(42);
+    uniform_int_distribution<SimTime> arrivalDist(0, config.maxArrivalTime);
+    uniform_int_distribution<SimTime> burstDist(config.minBurstTime, config.maxBurstTime);
+    vector<JobSpec> jobs(static_cast<size_t>(numProcesses));
+    for (auto& job : jobs)
+    {
+        job.arrivalTime = arrivalDist(gen);
+        job.burstTime = burstDist(gen);
+    }
+
+    // Completed jobs are retired as they finish, so only the jobs still
+    // pending or running occupy the process table. Retention does not cover
+    // the Gantt log, which would keep several spans per job, so it is off
+    MLFQScheduler scheduler(config);
+    scheduler.setRetention(CompletedRetention::DISCARD);
+    scheduler.setExecutionLogging(false);
+    if (!spillPath.empty() && !scheduler.setSpillFile(spillPath, error))
+    {
+        cout << TerminalUI::Style::error("Scale run failed: " + error) << "\n";
+        return 1;
+    }
+
+    auto startTime = chrono::high_resolution_clock::now();
+    scheduler.loadWorkload(jobs);
+    auto loadedTime = chrono::high_resolution_clock::now();
+    scheduler.runToCompletion();
+    auto endTime = chrono::high_resolution_clock::now();
+
+    auto stats = scheduler.getStats();
+    auto report = scheduler.getCompletionReport();
+    cout << "  Load:            " << chrono::duration_cast<chrono::milliseconds>(loadedTime - startTime).count() << " ms\n";
+    cout << "  Run:             " << chrono::duration_cast<chrono::milliseconds>(endTime - loadedTime).count() << " ms\n";
+    cout << "  Simulated time:  " << config.formatTicks(stats.currentTime) << "\n";
+    cout << "  Avg wait:        " << config.formatTicks(static_cast<SimTime>(stats.avgWaitTime)) << "\n";
+    cout << "  Avg turnaround:  " << config.formatTicks(static_cast<SimTime>(stats.avgTurnaroundTime)) << "\n";
+    cout << "  Longest wait:    P" << report.maxWaitPid << " (" << config.formatTicks(report.maxWaitTime) << ")\n";
+    cout << fixed << setprecision(1);
+    cout << "  CPU utilization: " << stats.cpuUtilization << "%\n";
+    if (!spillPath.empty())
+    {
+        cout << "  Results:         " << scheduler.getCompletedProcesses().size() << " records in " << spillPath << "\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    // --replay FILE verifies a recording and exits; --scale N runs N random
+    // jobs with the scale profile and exits, writing their results to
+    // --spill FILE if given, with ticks of --tick DURATION (1us default);
+    // --record FILE saves the inputs of each run started from the menu
+    string recordPath;
+    string spillPath;
+    SimTime tickLength = TIME_US;
+    bool scaleRun = false;
+    long long scaleProcesses = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "--replay" && i + 1 < argc)
+        {
+            return runReplayMode(argv[++i]);
+        }
+        if (arg == "--scale" && i + 1 < argc)
+        {
+            scaleRun = true;
+            scaleProcesses = atoll(argv[++i]);
+        }
+        if (arg == "--spill" && i + 1 < argc)
+        {
+            spillPath = argv[++i];
+        }
+        if (arg == "--tick" && i + 1 < argc)
+        {
+            string error;
+            if (!parseDuration(argv[++i], tickLength, error) || tickLength < 1)
+            {
+                cout << TerminalUI::Style::error(error.empty() ? "Tick must be at least 1ns" : error) << "\n";
+                return 1;
+            }
+        }
+        if (arg == "--record" && i + 1 < argc)
+        {
+            recordPath = argv[++i];
+        }
+    }
+    if (scaleRun)
+    {
+        return runScaleMode(scaleProcesses, tickLength, spillPath);
+    }
+
     SchedulerConfig config;  // Default configuration
     unique_ptr<MLFQScheduler> scheduler = make_unique<MLFQScheduler>(config);
     unique_ptr<Visualizer> viz = make_unique<Visualizer>(*scheduler);
+    ReplayLog recording;
 
     while (true)
     {
+        // Save the run that just returned to the menu, then record the next one
+        if (!recordPath.empty())
+        {
+            if (scheduler->getRecorder() && !recording.getEvents().empty())
+            {
+                string error;
+                if (!recording.finish(*scheduler, error) || !recording.save(recordPath, error))
+                {
+                    cout << TerminalUI::Style::error(error) << "\n";
+                }
+            }
+            scheduler->setRecorder(&recording);
+        }
+
         displayMenu();
 
         int choice;
@@ -825,17 +984,18 @@ int main()
 
                 random_device rd;
                 mt19937 gen(rd());
-                uniform_int_distribution<> arrivalDist(0, config.maxArrivalTime);
-                uniform_int_distribution<> burstDist(config.minBurstTime, config.maxBurstTime);
+                uniform_int_distribution<SimTime> arrivalDist(0, config.maxArrivalTime);
+                uniform_int_distribution<SimTime> burstDist(config.minBurstTime, config.maxBurstTime);
 
                 cout << "\nGenerating " << config.numProcesses << " random processes...\n";
                 cout << "  Arrival time range: 0-" << config.maxArrivalTime << " ms\n";
                 cout << "  Burst time range: " << config.minBurstTime << "-" << config.maxBurstTime << " ms\n\n";
 
-                for (int i = 0; i < config.numProcesses; i++)
+                scheduler->reserve(static_cast<size_t>(config.numProcesses));
+                for (long long i = 0; i < config.numProcesses; i++)
                 {
-                    int arrival = arrivalDist(gen);
-                    int burst = burstDist(gen);
+                    SimTime arrival = arrivalDist(gen);
+                    SimTime burst = burstDist(gen);
                     scheduler->addProcess(arrival, burst);
                     cout << "  P" << (i+1) << ": Arrival=" << arrival << "ms, Burst=" << burst << "ms\n";
                 }
@@ -882,17 +1042,18 @@ int main()
 
                 random_device rd;
                 mt19937 gen(rd());
-                uniform_int_distribution<> arrivalDist(0, config.maxArrivalTime);
-                uniform_int_distribution<> burstDist(config.minBurstTime, config.maxBurstTime);
+                uniform_int_distribution<SimTime> arrivalDist(0, config.maxArrivalTime);
+                uniform_int_distribution<SimTime> burstDist(config.minBurstTime, config.maxBurstTime);
 
                 cout << "\nGenerating " << config.numProcesses << " random processes...\n";
                 cout << "  Arrival time range: 0-" << config.maxArrivalTime << " ms\n";
                 cout << "  Burst time range: " << config.minBurstTime << "-" << config.maxBurstTime << " ms\n\n";
 
-                for (int i = 0; i < config.numProcesses; i++)
+                scheduler->reserve(static_cast<size_t>(config.numProcesses));
+                for (long long i = 0; i < config.numProcesses; i++)
                 {
-                    int arrival = arrivalDist(gen);
-                    int burst = burstDist(gen);
+                    SimTime arrival = arrivalDist(gen);
+                    SimTime burst = burstDist(gen);
                     scheduler->addProcess(arrival, burst);
                     cout << "  P" << (i+1) << ": Arrival=" << arrival << "ms, Burst=" << burst << "ms\n";
                 }
@@ -1194,6 +1355,22 @@ void runWebGUIMode(MLFQScheduler& scheduler)
     // Create and start web server
     WebServer webServer(&scheduler, 8080);
     webServer.start();
+
+    // The server thread only calls submit(). This thread owns the scheduler
+    // and runs its clock in real time, so jobs sent to /submit are admitted
+    // and scheduled while the page is open
+    atomic<bool> driving(true);
+    thread driver([&scheduler, &driving]()
+    {
+        SimTime origin = scheduler.getCurrentTime();
+        auto start = chrono::steady_clock::now();
+        while (driving.load())
+        {
+            this_thread::sleep_for(chrono::milliseconds(10));
+            SimTime elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+            scheduler.runUntil(origin + scheduler.getConfig().toTicks(elapsed));
+        }
+    });
     
     // Give server time to start
     this_thread::sleep_for(chrono::milliseconds(500));
@@ -1206,5 +1383,10 @@ void runWebGUIMode(MLFQScheduler& scheduler)
     cin.get();
     
     webServer.stop();
-    cout << "\nWeb server stopped.\n";
+    driving.store(false);
+    driver.join();
+    scheduler.acceptSubmissions();  // Jobs sent just before the server stopped
+    auto stats = scheduler.getStats();
+    cout << "\nWeb server stopped at " << scheduler.getConfig().formatTicks(stats.currentTime)
+         << " (" << stats.completedProcesses << " of " << stats.totalProcesses << " processes completed).\n";
 }
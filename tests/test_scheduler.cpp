@@ -1,7 +1,20 @@
 #include "MLFQScheduler.h"
+#include "MultiCoreScheduler.h"
+#include "ReplayLog.h"
+#include "SchedulerEngine.h"
+#include "SimdKernels.h"
 #include "Visualizer.h"
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <thread>
+#include <atomic>
 
 void testProcessCreation() 
 {
@@ -21,11 +34,13 @@ void testQueueOperations()
 {
     std::cout << "Testing Queue Operations... ";
     
+    ProcessTable table;
     ProcessQueue queue(0, 4);
+    queue.bindTable(&table);
     assert(queue.isEmpty());
     
-    auto p1 = std::make_shared<Process>(1, 0, 10);
-    auto p2 = std::make_shared<Process>(2, 0, 20);
+    ProcessSlot p1 = table.add(1, 0, 10);
+    ProcessSlot p2 = table.add(2, 0, 20);
     
     queue.enqueue(p1);
     assert(!queue.isEmpty());
@@ -35,12 +50,321 @@ void testQueueOperations()
     assert(queue.size() == 2);
     
     auto dequeued = queue.dequeue();
-    assert(dequeued->getPid() == 1);
+    assert(table.getPid(dequeued) == 1);
     assert(queue.size() == 1);
     
     std::cout << "PASSED\n";
 }
 
+void testOrderedQueue()
+{
+    std::cout << "Testing Ordered Queue... ";
+
+    ProcessTable table;
+    ProcessQueue queue(2, 16, QueueOrder::SHORTEST_REMAINING_FIRST);
+    queue.bindTable(&table);
+    int bursts[] = {9, 3, 7, 3, 12, 1};
+    std::vector<ProcessSlot> processes;
+    for (int i = 0; i < 6; i++)
+    {
+        processes.push_back(table.add(i + 1, 0, bursts[i]));
+        queue.enqueue(processes.back());
+    }
+
+    // Arbitrary removal through the process slot
+    assert(queue.removeSlot(processes[2]));
+    assert(!queue.removeSlot(processes[2]));
+    assert(queue.size() == 5);
+
+    // Shortest first, equal bursts in enqueue order
+    int expected[] = {6, 2, 4, 1, 5};
+    for (int pid : expected)
+    {
+        assert(table.getPid(queue.dequeue()) == pid);
+    }
+    assert(queue.isEmpty());
+    assert(queue.dequeue() == NO_PROCESS);
+
+    // Switching back to FIFO keeps the current queue order
+    for (ProcessSlot p : processes)
+    {
+        queue.enqueue(p);
+    }
+    queue.setOrder(QueueOrder::FIFO);
+    assert(table.getPid(queue.dequeue()) == 6);
+    assert(table.getPid(queue.dequeue()) == 2);
+    assert(table.getPid(queue.dequeue()) == 4);
+
+    std::cout << "PASSED\n";
+}
+
+static std::vector<int> queuedPids(const ProcessQueue& queue)
+{
+    std::vector<int> pids;
+    for (const auto& process : queue.getProcesses())
+    {
+        pids.push_back(process->getPid());
+    }
+    return pids;
+}
+
+void testIntrusiveQueue()
+{
+    std::cout << "Testing Intrusive Queue... ";
+
+    ProcessTable table;
+    MultilevelQueue levels(std::vector<SimTime>{2, 4, 8});
+    levels.bindTable(&table);
+    for (int pid = 1; pid <= 6; pid++)
+    {
+        ProcessSlot slot = table.add(pid, 0, 5);
+        levels[pid <= 4 ? 1 : 2].enqueue(slot);
+    }
+
+    // Unlink the middle, head and tail of level 1
+    assert(levels[1].removeSlot(1));
+    assert(!levels[1].removeSlot(1));
+    assert(levels[1].removeProcess(1));
+    assert(levels[1].removeProcess(4));
+    assert(!levels[1].removeProcess(4));
+    assert(queuedPids(levels[1]) == std::vector<int>({3}));
+
+    // Moving between levels updates both ready bits
+    assert(levels.moveProcess(2, 1, 0));
+    assert(levels.getReadyMask() == 0x5);
+    assert(levels.highestReadyLevel() == 0);
+    assert(levels[0].peek() == 2 && table.getPriority(2) == 0);
+
+    // Splicing appends the whole level in order and empties it
+    levels[0].enqueue(0);
+    levels[0].splice(levels[2]);
+    assert(queuedPids(levels[0]) == std::vector<int>({3, 1, 5, 6}));
+    assert(levels[2].isEmpty() && levels[0].size() == 4);
+    assert(levels.getReadyMask() == 0x1);
+
+    int expected[] = {3, 1, 5, 6};
+    for (int pid : expected)
+    {
+        assert(table.getPid(levels[0].dequeue()) == pid);
+    }
+    assert(levels.isEmpty());
+
+    std::cout << "PASSED\n";
+}
+
+void testLazyBoost()
+{
+    std::cout << "Testing Lazy Boost... ";
+
+    MLFQScheduler scheduler(3, 20);  // Quantums 4, 8, 16
+    for (int i = 0; i < 4; i++)
+    {
+        scheduler.addProcess(0, 20);
+    }
+
+    for (int t = 0; t < 19; t++)
+    {
+        scheduler.step();
+    }
+    assert(scheduler.getQueues()[0].isEmpty());
+    assert(!scheduler.getQueues()[1].isEmpty());
+    assert(scheduler.getQueues()[1].getProcesses().front()->getPriority() == 1);
+
+    // The boost at t=20 only relinks levels, yet every process reads level 0
+    scheduler.step();
+    const auto& queues = scheduler.getQueues();
+    assert(queues[0].size() == 4 && queues[1].isEmpty() && queues[2].isEmpty());
+    for (const auto& process : scheduler.getAllProcesses())
+    {
+        assert(process->getState() == ProcessState::READY);
+        assert(process->getPriority() == 0);
+    }
+
+    // Dispatched from queue 0, the process runs with queue 0's quantum
+    scheduler.step();
+    auto current = scheduler.getCurrentProcess();
+    assert(current && current->getPriority() == 0);
+    for (int t = 0; t < 3; t++)
+    {
+        scheduler.step();
+    }
+    assert(!scheduler.getCurrentProcess());
+    assert(current->getPriority() == 1);
+
+    std::cout << "PASSED\n";
+}
+
+void testBoostKeepsArrivalTies()
+{
+    std::cout << "Testing Boost Keeps Arrival Ties... ";
+
+    // Everything arrives at 0, so a boost out of the priority queue must
+    // keep the order the processes were queued in, as the sorted deque did
+    SchedulerConfig config;
+    config.numQueues = 2;
+    config.boostInterval = 14;
+    config.baseQuantum = 2;
+    MLFQScheduler scheduler(config);
+    scheduler.setLastQueueAlgorithm(LastQueueAlgorithm::PRIORITY_SCHEDULING);
+    int bursts[] = {11, 17, 9, 7};
+    for (int burst : bursts)
+    {
+        scheduler.addProcess(0, burst);
+    }
+
+    while (scheduler.getCurrentTime() < 27)
+    {
+        scheduler.step();
+    }
+    assert(scheduler.getQueues()[1].size() == 3);
+    scheduler.step();  // Second boost at t=28
+    assert(queuedPids(scheduler.getQueues()[0]) == std::vector<int>({1, 2, 3, 4}));
+
+    while (!scheduler.isComplete())
+    {
+        scheduler.step();
+    }
+    std::vector<int> ran;
+    for (const auto& record : scheduler.getExecutionLog())
+    {
+        if (record.startTime >= 28 && record.startTime < 32)
+        {
+            ran.push_back(record.pid);
+        }
+    }
+    assert(ran == std::vector<int>({1, 2}));
+
+    std::cout << "PASSED\n";
+}
+
+void testProcessTableViews()
+{
+    std::cout << "Testing Process Table Views... ";
+
+    MLFQScheduler scheduler(3, 100);
+    scheduler.addProcess(0, 4);
+    scheduler.addProcess(Process(99, 2, 3));  // PID is reassigned
+    assert(!scheduler.getCurrentProcess());
+
+    scheduler.step();
+    auto current = scheduler.getCurrentProcess();
+    assert(current && current->getPid() == 1);
+    assert(current->getState() == ProcessState::RUNNING);
+    assert(current->getRemainingTime() == 3);
+
+    // Views read straight from the table, so they follow the schedule
+    auto all = scheduler.getAllProcesses();
+    assert(all.size() == 2);
+    assert(all.front() == current && all.back() != current);
+    assert(all.back()->getPid() == 2 && all.back()->getArrivalTime() == 2);
+
+    while (!scheduler.isComplete())
+    {
+        scheduler.step();
+    }
+    assert(current->getState() == ProcessState::TERMINATED);
+    assert(current->getCompletionTime() == 4);
+
+    // Copies own their table: running the copy leaves the original alone
+    MLFQScheduler copy(3, 100);
+    copy.addProcess(0, 5);
+    MLFQScheduler snapshot(copy);
+    snapshot.step();
+    assert(snapshot.getCurrentProcess()->getRemainingTime() == 4);
+    assert(copy.getAllProcesses()[0]->getRemainingTime() == 5);
+
+    int completed = 0;
+    for (const auto& process : scheduler.getCompletedProcesses())
+    {
+        assert(process->getTurnaroundTime() == process->getCompletionTime() - process->getArrivalTime());
+        completed++;
+    }
+    assert(completed == 2);
+
+    std::cout << "PASSED\n";
+}
+
+void testReportColumns()
+{
+    std::cout << "Testing Report Columns... ";
+
+    ProcessTable table;
+    ProcessSlot a = table.add(1, 2, 10);
+    ProcessSlot b = table.add(2, 0, 4);
+
+    // Nothing completed yet: report fields read as zero
+    assert(table.getCompletionTime(a) == 0 && table.getTurnaroundTime(b) == 0);
+
+    table.execute(b, 3, 1);
+    assert(table.getCpuTimeUsed(b) == 3 && table.getRemainingTime(b) == 1);
+    table.execute(b, 3, 4);
+    assert(table.getState(b) == ProcessState::TERMINATED && table.getCpuTimeUsed(b) == 4);
+    table.setCompletionTime(b, 5);
+    table.calculateMetrics(b, 5);
+    assert(table.getTurnaroundTime(b) == 5 && table.getWaitTime(b) == 1);
+    assert(table.getCompletionTime(a) == 0);
+
+    // A copy shares the report chunk until one side writes it
+    ProcessTable copy(table);
+    table.setCompletionTime(a, 40);
+    assert(copy.getCompletionTime(a) == 0 && copy.getCompletionTime(b) == 5);
+
+    // Reused slots do not inherit the previous workload's report
+    table.clear();
+    ProcessSlot c = table.add(7, 0, 3);
+    ProcessSlot d = table.add(8, 0, 3);
+    assert(table.getCompletionTime(c) == 0 && table.getCompletionTime(d) == 0);
+    assert(table.getTurnaroundTime(d) == 0 && table.getCpuTimeUsed(d) == 0);
+
+    std::cout << "PASSED\n";
+}
+
+void testDeepQueueLevels()
+{
+    std::cout << "Testing 64 Queue Levels... ";
+
+    SchedulerConfig config;
+    config.numQueues = 64;
+    config.baseQuantum = 2;
+    config.quantumMultiplier = 1.5;
+    config.boostInterval = 500;
+
+    std::string error;
+    assert(config.validate(error));
+    config.numQueues = 65;
+    assert(!config.validate(error));
+    config.numQueues = 64;
+
+    // Quantums grow geometrically and saturate instead of overflowing
+    auto quantums = config.buildQuantumTable();
+    assert(quantums.size() == 64);
+    assert(quantums[0] == 2 && quantums[1] == 3 && quantums[2] == 4);
+    assert(quantums[63] > std::numeric_limits<int>::max());   // 64-bit time: past 32 bits
+    assert(config.getQuantumForQueue(5) == quantums[5]);
+    SchedulerConfig steep = config;
+    steep.quantumMultiplier = 5.0;
+    assert(steep.buildQuantumTable()[63] == SIM_TIME_MAX);
+
+    MLFQScheduler scheduler(config);
+    scheduler.addProcess(0, 200);
+    scheduler.addProcess(0, 1);
+    scheduler.stepEvent();
+
+    // The ready bitmap tracks exactly the non-empty levels
+    const auto& queues = scheduler.getQueues();
+    assert(queues.size() == 64);
+    assert(queues[0].size() == 1 && queues[1].size() == 1 && queues[2].isEmpty());
+
+    while (!scheduler.isComplete())
+    {
+        scheduler.stepEvent();
+    }
+    assert(scheduler.getCompletedProcesses().size() == 2);
+    assert(scheduler.getExecutionLog().back().queueLevel > 5);
+
+    std::cout << "PASSED\n";
+}
+
 void testSchedulerBasics() 
 {
     std::cout << "Testing Scheduler Basics... ";
@@ -110,6 +434,1365 @@ void testMetricsCalculation()
     std::cout << "PASSED\n";
 }
 
+void testStreamingStats()
+{
+    std::cout << "Testing Streaming Statistics... ";
+
+    MLFQScheduler scheduler(4, 60);
+    for (int i = 0; i < 40; i++)
+    {
+        scheduler.addProcess(i * 7, 5 + (i * 37) % 90);
+    }
+    while (!scheduler.isComplete())
+    {
+        scheduler.stepEvent();
+    }
+
+    // Running totals agree with a walk over the completed processes
+    long long wait = 0, turnaround = 0, response = 0, burst = 0;
+    for (const auto& process : scheduler.getCompletedProcesses())
+    {
+        wait += process->getWaitTime();
+        turnaround += process->getTurnaroundTime();
+        response += process->getResponseTime();
+        burst += process->getBurstTime();
+    }
+    auto stats = scheduler.getStats();
+    assert(stats.avgWaitTime == static_cast<double>(wait) / 40);
+    assert(stats.avgTurnaroundTime == static_cast<double>(turnaround) / 40);
+    assert(stats.avgResponseTime == static_cast<double>(response) / 40);
+    assert(stats.cpuBusyTime == burst);
+
+    // Per-level busy time matches the execution log
+    const auto& queueStats = scheduler.getQueueStats();
+    assert(queueStats.size() == 4);
+    std::vector<long long> logged(4, 0);
+    for (const auto& span : scheduler.getExecutionLog())
+    {
+        logged[span.queueLevel] += span.endTime - span.startTime;
+    }
+    long long busy = 0;
+    for (int level = 0; level < 4; level++)
+    {
+        assert(queueStats[level].busyTime == logged[level]);
+        busy += queueStats[level].busyTime;
+    }
+    assert(busy == burst);
+    assert(queueStats[0].dispatches >= 40);
+
+    scheduler.reset();
+    assert(scheduler.getStats().cpuBusyTime == 0);
+    assert(scheduler.getQueueStats()[0].dispatches == 0);
+
+    std::cout << "PASSED\n";
+}
+
+// Expand the execution log into one pid per time unit (-1 = idle)
+static std::vector<int> expandLog(const MLFQScheduler& scheduler)
+{
+    std::vector<int> ticks(scheduler.getCurrentTime(), -1);
+    for (const auto& record : scheduler.getExecutionLog())
+    {
+        for (SimTime t = record.startTime; t < record.endTime; t++)
+        {
+            ticks[t] = record.pid;
+        }
+    }
+    return ticks;
+}
+
+static void loadRandomWorkload(MLFQScheduler& scheduler, unsigned seed, int count)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> arrivalDist(0, 120);
+    std::uniform_int_distribution<> burstDist(1, 60);
+    for (int i = 0; i < count; i++)
+    {
+        scheduler.addProcess(arrivalDist(gen), burstDist(gen));
+    }
+}
+
+void testEventEngineMatchesTicks()
+{
+    std::cout << "Testing Event Engine Equivalence... ";
+
+    LastQueueAlgorithm algos[] =
+    {
+        LastQueueAlgorithm::ROUND_ROBIN,
+        LastQueueAlgorithm::SHORTEST_JOB_FIRST,
+        LastQueueAlgorithm::PRIORITY_SCHEDULING
+    };
+
+    for (unsigned seed = 1; seed <= 20; seed++)
+    {
+        for (auto algo : algos)
+        {
+            SchedulerConfig config;
+            config.numQueues = 2 + seed % 4;
+            config.boostInterval = 20 + 7 * seed;
+            config.baseQuantum = 2 + seed % 5;
+
+            MLFQScheduler ticked(config);
+            MLFQScheduler evented(config);
+            ticked.setLastQueueAlgorithm(algo);
+            evented.setLastQueueAlgorithm(algo);
+            loadRandomWorkload(ticked, seed, 12);
+            loadRandomWorkload(evented, seed, 12);
+
+            while (!ticked.isComplete()) ticked.step();
+            while (!evented.isComplete()) evented.stepEvent();
+
+            assert(ticked.getCurrentTime() == evented.getCurrentTime());
+            assert(evented.getExecutionLog().size() == ticked.getExecutionLog().size());
+            assert(expandLog(ticked) == expandLog(evented));
+
+            const auto& a = ticked.getAllProcesses();
+            const auto& b = evented.getAllProcesses();
+            for (size_t i = 0; i < a.size(); i++)
+            {
+                assert(a[i]->getCompletionTime() == b[i]->getCompletionTime());
+                assert(a[i]->getWaitTime() == b[i]->getWaitTime());
+                assert(a[i]->getResponseTime() == b[i]->getResponseTime());
+                assert(a[i]->getLastRunTime() == b[i]->getLastRunTime());
+            }
+        }
+    }
+
+    std::cout << "PASSED\n";
+}
+
+void testArrivalOrdering()
+{
+    std::cout << "Testing Arrival Ordering... ";
+
+    MLFQScheduler scheduler(3, 100);
+
+    // Added out of arrival order; equal arrivals keep insertion order
+    scheduler.addProcess(10, 2);
+    scheduler.addProcess(0, 3);
+    scheduler.addProcess(10, 1);
+    assert(scheduler.hasProcesses());
+
+    while (!scheduler.isComplete())
+    {
+        scheduler.stepEvent();
+    }
+
+    const auto& completed = scheduler.getCompletedProcesses();
+    assert(completed.size() == 3);
+    assert(completed[0]->getPid() == 2 && completed[0]->getCompletionTime() == 3);
+    assert(completed[1]->getPid() == 1 && completed[1]->getCompletionTime() == 12);
+    assert(completed[2]->getPid() == 3 && completed[2]->getCompletionTime() == 13);
+    assert(!scheduler.hasProcesses());
+
+    // A process added after its arrival time is admitted on the next tick
+    scheduler.addProcess(5, 2);
+    assert(scheduler.hasProcesses());
+    while (!scheduler.isComplete())
+    {
+        scheduler.step();
+    }
+    assert(scheduler.getCompletedProcesses().back()->getCompletionTime() == 15);
+
+    std::cout << "PASSED\n";
+}
+
+void testExecutionLogCompression()
+{
+    std::cout << "Testing Execution Log Compression... ";
+
+    MLFQScheduler scheduler(3, 100);
+    scheduler.addProcess(0, 6);
+    scheduler.addProcess(0, 2);
+
+    while (!scheduler.isComplete())
+    {
+        scheduler.step();
+    }
+
+    // P1 runs its 4-unit quantum, P2 finishes, P1 finishes in queue 1
+    const auto& log = scheduler.getExecutionLog();
+    assert(log.size() == 3);
+    assert(log[0].pid == 1 && log[0].startTime == 0 && log[0].endTime == 4 && log[0].queueLevel == 0);
+    assert(log[1].pid == 2 && log[1].startTime == 4 && log[1].endTime == 6);
+    assert(log[2].pid == 1 && log[2].startTime == 6 && log[2].endTime == 8 && log[2].queueLevel == 1);
+
+    auto ticks = scheduler.getExecutionTicks();
+    assert(ticks.size() == 8);
+    for (int t = 0; t < 8; t++)
+    {
+        assert(ticks[t].startTime == t && ticks[t].endTime == t + 1);
+    }
+    assert(ticks[5].pid == 2 && ticks[7].pid == 1);
+
+    std::cout << "PASSED\n";
+}
+
+void testLazyWaitAccounting()
+{
+    std::cout << "Testing Lazy Wait Accounting... ";
+
+    MLFQScheduler scheduler(3, 100);
+    scheduler.addProcess(0, 10);
+    scheduler.addProcess(0, 10);
+
+    scheduler.step();
+    scheduler.step();
+
+    // P2 has been ready for two ticks but nothing has been folded in yet
+    auto waiting = scheduler.getAllProcesses()[1];
+    assert(waiting->getState() == ProcessState::READY);
+    assert(waiting->getWaitTime() == 0);
+    assert(waiting->getWaitTimeAt(scheduler.getCurrentTime()) == 2);
+
+    // Dispatch at t=4 (end of P1's quantum) folds the wait into the process
+    scheduler.step();
+    scheduler.step();
+    scheduler.step();
+    assert(scheduler.getCurrentProcess() == waiting);
+    assert(waiting->getWaitTime() == 4);
+
+    std::cout << "PASSED\n";
+}
+
+// FNV-1a fingerprint of the per-tick schedule and per-process metrics
+static uint64_t scheduleFingerprint(const MLFQScheduler& scheduler)
+{
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](long long value)
+    {
+        hash ^= static_cast<uint64_t>(value);
+        hash *= 1099511628211ULL;
+    };
+    for (int pid : expandLog(scheduler))
+    {
+        mix(pid);
+    }
+    for (const auto& process : scheduler.getAllProcesses())
+    {
+        mix(process->getCompletionTime());
+        mix(process->getWaitTime());
+        mix(process->getResponseTime());
+    }
+    return hash;
+}
+
+void testGoldenSchedules()
+{
+    std::cout << "Testing Golden Schedules... ";
+
+    // Fingerprints recorded from the reference tick-by-tick engine
+    struct Golden
+    {
+        unsigned seed;
+        int algorithm;
+        uint64_t fingerprint;
+    };
+    const Golden golden[] =
+    {
+        {100u, 0, 0xaeca610e8efa5356ULL},
+        {100u, 1, 0x99fa251ec9af6cf3ULL},
+        {100u, 2, 0xb66302d7ed6a2579ULL},
+        {101u, 0, 0xdacf07d37908f5e6ULL},
+        {101u, 1, 0xde2cb6555e897b90ULL},
+        {101u, 2, 0x612f46c7ffbe6b64ULL},
+        {102u, 0, 0x3e557925202d8fcdULL},
+        {102u, 1, 0x7cee22ebc9ee2545ULL},
+        {102u, 2, 0x270c0b92ac476e5dULL},
+        {103u, 0, 0xab7ce5f6331c4b4aULL},
+        {103u, 1, 0xab7ce5f6331c4b4aULL},
+        {103u, 2, 0xab7ce5f6331c4b4aULL},
+        {104u, 0, 0x7cf5b87c029dfe85ULL},
+        {104u, 1, 0x60dd5e530a81e49bULL},
+        {104u, 2, 0x190e5498c1c42d64ULL},
+        {105u, 0, 0xba09b8e6ad8cb435ULL},
+        {105u, 1, 0x8e8c03b7b81d3989ULL},
+        {105u, 2, 0x30a92e98d6896bcfULL},
+        {106u, 0, 0x40ceca0f442df534ULL},
+        {106u, 1, 0x40ceca0f442df534ULL},
+        {106u, 2, 0x40ceca0f442df534ULL},
+        {107u, 0, 0xa04e719d398fd154ULL},
+        {107u, 1, 0xa04e719d398fd154ULL},
+        {107u, 2, 0xa04e719d398fd154ULL},
+        {108u, 0, 0xf3efaf778cffef26ULL},
+        {108u, 1, 0x1031c7ee4e2dce3dULL},
+        {108u, 2, 0x06f114f06b9ef9c0ULL},
+        {109u, 0, 0x85a04977d013cfe4ULL},
+        {109u, 1, 0x20c348e800176442ULL},
+        {109u, 2, 0x083595422d1f942eULL},
+        {110u, 0, 0x53ab9cd9c25b763fULL},
+        {110u, 1, 0x53ab9cd9c25b763fULL},
+        {110u, 2, 0x53ab9cd9c25b763fULL},
+        {111u, 0, 0x0ee2c644123f41e0ULL},
+        {111u, 1, 0x0ee2c644123f41e0ULL},
+        {111u, 2, 0x0ee2c644123f41e0ULL},
+    };
+
+    LastQueueAlgorithm algos[] =
+    {
+        LastQueueAlgorithm::ROUND_ROBIN,
+        LastQueueAlgorithm::SHORTEST_JOB_FIRST,
+        LastQueueAlgorithm::PRIORITY_SCHEDULING
+    };
+
+    for (const auto& g : golden)
+    {
+        SchedulerConfig config;
+        config.numQueues = 2 + g.seed % 4;
+        config.boostInterval = 25 + 11 * (g.seed % 7);
+        config.baseQuantum = 2 + g.seed % 3;
+
+        MLFQScheduler scheduler(config);
+        scheduler.setLastQueueAlgorithm(algos[g.algorithm]);
+
+        std::mt19937 gen(g.seed);
+        std::uniform_int_distribution<> arrivalDist(0, 90);
+        std::uniform_int_distribution<> burstDist(1, 80);
+        for (int i = 0; i < 14; i++)
+        {
+            int arrival = arrivalDist(gen);
+            scheduler.addProcess(arrival, burstDist(gen));
+        }
+
+        while (!scheduler.isComplete())
+        {
+            scheduler.step();
+        }
+        assert(scheduleFingerprint(scheduler) == g.fingerprint);
+    }
+
+    std::cout << "PASSED\n";
+}
+
+void testTableReuse()
+{
+    std::cout << "Testing Process Table Reuse... ";
+
+    // Slots past the first chunk read and write like any other
+    ProcessTable table;
+    size_t count = ProcessTable::CHUNK_SIZE + 5;
+    for (size_t i = 0; i < count; i++)
+    {
+        table.add(static_cast<int>(i + 1), static_cast<int>(i), 3);
+    }
+    ProcessSlot last = static_cast<ProcessSlot>(count - 1);
+    table.execute(last, 2, 10);
+    assert(table.getPid(last) == static_cast<int>(count));
+    assert(table.getRemainingTime(last) == 1);
+    assert(table.getRemainingTime(0) == 3);
+    assert(table.capacity() == 2 * ProcessTable::CHUNK_SIZE);
+
+    // Clearing keeps the chunks, and re-added processes start fresh
+    table.clear();
+    assert(table.empty() && table.capacity() == 2 * ProcessTable::CHUNK_SIZE);
+    table.add(7, 0, 4);
+    assert(table.getRemainingTime(0) == 4 && table.isFirstRun(0));
+
+    // A reset scheduler replays the same workload identically
+    MLFQScheduler scheduler(3, 40);
+    scheduler.reserve(200);
+    loadRandomWorkload(scheduler, 7, 200);
+    while (!scheduler.isComplete()) scheduler.stepEvent();
+    uint64_t first = scheduleFingerprint(scheduler);
+
+    scheduler.reset();
+    assert(scheduler.getAllProcesses().empty());
+    loadRandomWorkload(scheduler, 7, 200);
+    while (!scheduler.isComplete()) scheduler.stepEvent();
+    assert(scheduleFingerprint(scheduler) == first);
+
+    std::cout << "PASSED\n";
+}
+
+void testSingleCoreMatchesScheduler()
+{
+    std::cout << "Testing Single-Core Equivalence... ";
+
+    LastQueueAlgorithm algos[] = {
+        LastQueueAlgorithm::ROUND_ROBIN,
+        LastQueueAlgorithm::SHORTEST_JOB_FIRST,
+        LastQueueAlgorithm::PRIORITY_SCHEDULING
+    };
+    for (unsigned seed = 30; seed < 36; seed++)
+    {
+        for (auto algo : algos)
+        {
+            SchedulerConfig config;
+            config.numQueues = 2 + seed % 3;
+            config.boostInterval = 30 + 7 * (seed % 5);
+
+            MLFQScheduler single(config);
+            MultiCoreScheduler multi(config);
+            single.setLastQueueAlgorithm(algo);
+            multi.setLastQueueAlgorithm(algo);
+            loadRandomWorkload(single, seed, 15);
+            for (const auto& process : single.getAllProcesses())
+            {
+                multi.addProcess(process->getArrivalTime(), process->getBurstTime());
+            }
+
+            while (!single.isComplete()) single.step();
+            while (!multi.isComplete()) multi.step();
+
+            assert(multi.getCurrentTime() == single.getCurrentTime());
+            auto a = single.getAllProcesses();
+            auto b = multi.getAllProcesses();
+            for (size_t i = 0; i < a.size(); i++)
+            {
+                assert(a[i]->getCompletionTime() == b[i]->getCompletionTime());
+                assert(a[i]->getWaitTime() == b[i]->getWaitTime());
+                assert(a[i]->getResponseTime() == b[i]->getResponseTime());
+            }
+            assert(multi.getStats().avgTurnaroundTime == single.getStats().avgTurnaroundTime);
+        }
+    }
+
+    std::cout << "PASSED\n";
+}
+
+void testMultiCoreStealing()
+{
+    std::cout << "Testing Multi-Core Stealing... ";
+
+    SchedulerConfig config;
+    config.numCores = 2;
+    config.migrationPenalty = 3;
+    MultiCoreScheduler scheduler(config);
+
+    // P1 and P3 land on core 0, P2 on core 1
+    scheduler.addProcess(0, 40);
+    scheduler.addProcess(0, 6);
+    scheduler.addProcess(0, 40);
+
+    // Core 1 finishes P2 at t=6 and steals P1, which last ran on core 0
+    for (int t = 0; t < 7; t++)
+    {
+        scheduler.step();
+    }
+    assert(scheduler.getCurrentProcess(1)->getPid() == 1);
+    assert(scheduler.getCoreStats(1).steals == 1);
+    assert(scheduler.getCoreStats(1).migrations == 1);
+
+    while (!scheduler.isComplete())
+    {
+        scheduler.step();
+    }
+
+    // Busy time covers every burst; the penalty is accounted separately
+    const auto& core1 = scheduler.getCoreStats(1);
+    assert(core1.migrationTime == 3);
+    auto stats = scheduler.getStats();
+    assert(stats.cpuBusyTime == 86);
+    assert(scheduler.getCoreStats(0).busyTime + core1.busyTime == 86);
+    assert(stats.cpuUtilization > 50.0 && stats.cpuUtilization <= 100.0);
+    assert(scheduler.getCoreUtilization(0) > 0.0);
+    assert(scheduler.getTurnaroundPercentile(100) >= scheduler.getTurnaroundPercentile(50));
+    assert(scheduler.getTurnaroundPercentile(0) == 6);
+
+    // A core left idle does not steal from a peer that is about to dispatch
+    // the same process itself: P2 stays on core 1 with no stall
+    SchedulerConfig pair;
+    pair.numCores = 2;
+    pair.migrationPenalty = 5;
+    pair.baseQuantum = 4;
+    MultiCoreScheduler idle(pair);
+    idle.addProcess(0, 2);
+    idle.addProcess(0, 40);
+    while (!idle.isComplete())
+    {
+        idle.step();
+    }
+    for (int c = 0; c < 2; c++)
+    {
+        assert(idle.getCoreStats(c).steals == 0 && idle.getCoreStats(c).migrations == 0);
+        assert(idle.getCoreStats(c).migrationTime == 0);
+    }
+    assert(idle.getCurrentTime() == 40);
+
+    std::cout << "PASSED\n";
+}
+
+void testBulkRun()
+{
+    std::cout << "Testing Bulk Run API... ";
+
+    for (unsigned seed = 50; seed < 56; seed++)
+    {
+        SchedulerConfig config;
+        config.numQueues = 2 + seed % 4;
+        config.boostInterval = 20 + 9 * (seed % 5);
+
+        MLFQScheduler reference(config);
+        loadRandomWorkload(reference, seed, 14);
+        while (!reference.isComplete()) reference.step();
+        SimTime endTime = reference.getCurrentTime();
+
+        // Uneven runSteps chunks stop exactly where step() would
+        MLFQScheduler chunked(config);
+        loadRandomWorkload(chunked, seed, 14);
+        int chunk = 1;
+        while (chunked.getCurrentTime() < endTime)
+        {
+            SimTime target = std::min(chunked.getCurrentTime() + chunk, endTime);
+            MLFQScheduler ticked(chunked);
+            for (SimTime t = ticked.getCurrentTime(); t < target; t++) ticked.step();
+            chunked.runSteps(target - chunked.getCurrentTime());
+
+            assert(chunked.getCurrentTime() == target);
+            auto a = chunked.getCurrentProcess();
+            auto b = ticked.getCurrentProcess();
+            assert(!a == !b);
+            assert(!a || (a->getPid() == b->getPid() && a->getRemainingTime() == b->getRemainingTime()));
+            chunk = chunk * 3 % 17 + 1;
+        }
+        assert(chunked.isComplete());
+        assert(scheduleFingerprint(chunked) == scheduleFingerprint(reference));
+
+        // runToCompletion with logging off gives the same statistics
+        MLFQScheduler bulk(config);
+        loadRandomWorkload(bulk, seed, 14);
+        bulk.setExecutionLogging(false);
+        bulk.runToCompletion();
+        assert(bulk.getCurrentTime() == endTime);
+        assert(bulk.getExecutionLog().empty());
+        assert(bulk.getStats().avgWaitTime == reference.getStats().avgWaitTime);
+        assert(bulk.getStats().avgResponseTime == reference.getStats().avgResponseTime);
+    }
+
+    // runUntil idles the clock forward like step() does
+    MLFQScheduler idle(3, 100);
+    idle.addProcess(10, 2);
+    idle.runUntil(5);
+    assert(idle.getCurrentTime() == 5 && !idle.getCurrentProcess());
+    idle.runUntil(30);
+    assert(idle.getCurrentTime() == 30 && idle.isComplete());
+
+    std::cout << "PASSED\n";
+}
+
+void testTypedQueuePolicies()
+{
+    std::cout << "Testing Typed Queue Policies... ";
+
+    // push/pop with a policy type serve in the same order as enqueue/dequeue
+    ProcessTable table;
+    ProcessQueue untyped(0, 8, QueueOrder::LONGEST_WAIT_FIRST);
+    ProcessQueue typed(0, 8, QueueOrder::LONGEST_WAIT_FIRST);
+    untyped.bindTable(&table);
+    typed.bindTable(&table);
+    std::mt19937 gen(4);
+    std::uniform_int_distribution<> timeDist(0, 50);
+    std::vector<ProcessSlot> slots;
+    for (int i = 0; i < 40; i++)
+    {
+        ProcessSlot slot = table.add(i + 1, timeDist(gen), 5);
+        table.markReady(slot, timeDist(gen));
+        slots.push_back(slot);
+    }
+    for (ProcessSlot slot : slots)
+    {
+        untyped.enqueue(slot);
+    }
+    std::vector<ProcessSlot> expected;
+    while (!untyped.isEmpty())
+    {
+        expected.push_back(untyped.dequeue());
+    }
+    for (ProcessSlot slot : slots)
+    {
+        typed.push<LongestWaitOrder>(slot);
+    }
+    for (ProcessSlot slot : expected)
+    {
+        assert(typed.pop<LongestWaitOrder>() == slot);
+    }
+    assert(typed.pop<LongestWaitOrder>() == NO_PROCESS);
+
+    // Switching algorithm and logging mid-run re-selects the specialized
+    // core without disturbing the schedule
+    SchedulerConfig config;
+    config.numQueues = 3;
+    config.boostInterval = 45;
+    MLFQScheduler ticked(config);
+    MLFQScheduler bulk(config);
+    loadRandomWorkload(ticked, 8, 40);
+    loadRandomWorkload(bulk, 8, 40);
+    LastQueueAlgorithm order[] = {LastQueueAlgorithm::SHORTEST_JOB_FIRST,
+                                  LastQueueAlgorithm::PRIORITY_SCHEDULING,
+                                  LastQueueAlgorithm::ROUND_ROBIN};
+    for (int phase = 0; phase < 6; phase++)
+    {
+        ticked.setLastQueueAlgorithm(order[phase % 3]);
+        bulk.setLastQueueAlgorithm(order[phase % 3]);
+        bulk.setExecutionLogging(phase % 2 == 0);
+        for (int t = 0; t < 70; t++) ticked.step();
+        bulk.runSteps(70);
+        assert(bulk.getStats().avgWaitTime == ticked.getStats().avgWaitTime);
+        assert(bulk.getStats().completedProcesses == ticked.getStats().completedProcesses);
+    }
+
+    std::cout << "PASSED\n";
+}
+
+void testSnapshotFork()
+{
+    std::cout << "Testing Snapshot and Fork... ";
+
+    SchedulerConfig config;
+    config.numQueues = 4;
+    config.boostInterval = 40;
+
+    // More processes than one table chunk, so the fork shares several chunks
+    MLFQScheduler reference(config);
+    loadRandomWorkload(reference, 3, 1500);
+    reference.runToCompletion();
+    uint64_t straight = scheduleFingerprint(reference);
+
+    MLFQScheduler original(config);
+    loadRandomWorkload(original, 3, 1500);
+    original.runUntil(5000);
+    SchedulerSnapshot snap = original.snapshot();
+    assert(!snap.empty());
+
+    // What-if branch: different last-queue algorithm and boost interval from t=5000
+    MLFQScheduler branch = original.fork();
+    branch.setLastQueueAlgorithm(LastQueueAlgorithm::SHORTEST_JOB_FIRST);
+    branch.setBoostInterval(15);
+    branch.runToCompletion();
+
+    // The same switch made on a scheduler that replayed the prefix
+    MLFQScheduler replayed(config);
+    loadRandomWorkload(replayed, 3, 1500);
+    replayed.runUntil(5000);
+    replayed.setLastQueueAlgorithm(LastQueueAlgorithm::SHORTEST_JOB_FIRST);
+    replayed.setBoostInterval(15);
+    replayed.runToCompletion();
+    assert(scheduleFingerprint(branch) == scheduleFingerprint(replayed));
+    assert(branch.getBoostInterval() == 15);
+
+    // Writes to the branch never reach the original
+    assert(original.getCurrentTime() == 5000);
+    original.runToCompletion();
+    assert(scheduleFingerprint(original) == straight);
+
+    // Restoring rewinds to t=5000 and replays the same schedule
+    original.restore(snap);
+    assert(original.getCurrentTime() == 5000 && !original.isComplete());
+    original.runToCompletion();
+    assert(scheduleFingerprint(original) == straight);
+
+    std::cout << "PASSED\n";
+}
+
+void testReplayLog()
+{
+    std::cout << "Testing Replay Log... ";
+
+    SchedulerConfig config;
+    config.numQueues = 4;
+    config.boostInterval = 35;
+
+    // Record a run with mid-run switches and late submissions
+    ReplayLog recording;
+    MLFQScheduler scheduler(config);
+    scheduler.setRecorder(&recording);
+    loadRandomWorkload(scheduler, 21, 300);
+    scheduler.runUntil(1200);
+    scheduler.setLastQueueAlgorithm(LastQueueAlgorithm::PRIORITY_SCHEDULING);
+    scheduler.addProcess(1100, 25);     // Arrival already passed
+    scheduler.addProcess(1500, 40);
+    for (int i = 0; i < 30; i++) scheduler.step();
+    scheduler.setBoostInterval(60);
+    scheduler.runUntil(3000);
+    scheduler.setLastQueueAlgorithm(LastQueueAlgorithm::SHORTEST_JOB_FIRST);
+    scheduler.runToCompletion();
+    std::string error;
+    assert(recording.finish(scheduler, error));
+
+    assert(recording.getEvents().size() == 306);
+    assert(recording.getRecordedHash() == ReplayLog::hashExecutionLog(scheduler));
+
+    // Round trip through the binary encoding, then replay at full speed
+    std::vector<uint8_t> bytes = recording.serialize();
+    assert(bytes.size() < recording.getEvents().size() * 6 + 64);
+    ReplayLog loaded;
+    assert(loaded.deserialize(bytes, error));
+    assert(loaded.isFinished() && loaded.getRecordedHash() == recording.getRecordedHash());
+    assert(loaded.getConfig().boostInterval == 35 && loaded.getConfig().numQueues == 4);
+
+    MLFQScheduler replayed(loaded.getConfig());
+    ReplayResult result = loaded.replay(replayed);
+    assert(result.matches);
+    assert(result.endTime == scheduler.getCurrentTime());
+    assert(scheduleFingerprint(replayed) == scheduleFingerprint(scheduler));
+
+    // A different input changes the hash
+    ReplayLog altered;
+    assert(altered.deserialize(bytes, error));
+    altered.record(ReplayEvent::ADD_PROCESS, 0, 0, 5);
+    assert(altered.finish(scheduler, error));   // Stamps the original hash onto the altered inputs
+    assert(!altered.replay().matches);
+
+    // Truncated and foreign data are rejected
+    std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 3);
+    assert(!loaded.deserialize(truncated, error) && !error.empty());
+    std::vector<uint8_t> foreign(16, 0);
+    assert(!loaded.deserialize(foreign, error));
+
+    // reset() starts a new recording
+    scheduler.reset();
+    assert(recording.getEvents().empty() && !recording.isFinished());
+
+    // A bulk run without the execution log cannot be verified
+    MLFQScheduler unlogged(config);
+    ReplayLog blind;
+    unlogged.setRecorder(&blind);
+    loadRandomWorkload(unlogged, 22, 40);
+    unlogged.setExecutionLogging(false);
+    unlogged.runToCompletion();
+    assert(!blind.isLogComplete());
+    assert(!blind.finish(unlogged, error) && !error.empty() && !blind.isFinished());
+
+    // Neither can a rewind: restore() marks the recording and detaches it
+    MLFQScheduler rewound(config);
+    ReplayLog rewinds;
+    rewound.setRecorder(&rewinds);
+    loadRandomWorkload(rewound, 23, 40);
+    SchedulerSnapshot start = rewound.snapshot();
+    rewound.runUntil(200);
+    rewound.restore(start);
+    assert(!rewound.getRecorder() && !rewinds.isLogComplete());
+    rewound.runToCompletion();
+    assert(!rewinds.finish(rewound, error));
+
+    std::cout << "PASSED\n";
+}
+
+void testSimdKernels()
+{
+    std::cout << "Testing SIMD Kernels... ";
+
+    // Every instruction set this CPU has must agree with a plain loop,
+    // including lengths that leave a partial vector and repeated extremes
+    std::mt19937 rng(18);
+    std::uniform_int_distribution<int> small(-50, 50);
+    std::vector<int> sizes = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 31, 33, 100, 1023, 4099};
+    const SimdKernels::InstructionSet sets[] = {SimdKernels::InstructionSet::SCALAR,
+                                                 SimdKernels::InstructionSet::SSE2,
+                                                 SimdKernels::InstructionSet::AVX2};
+    for (auto set : sets)
+    {
+        if (!SimdKernels::select(set))
+        {
+            assert(set > SimdKernels::detected());
+            continue;
+        }
+        assert(SimdKernels::active() == set);
+        for (int n : sizes)
+        {
+            std::vector<int> values(n);
+            for (int& v : values) v = small(rng);
+            if (n > 10)
+            {
+                values[n / 3] = std::numeric_limits<int>::max();
+                values[n - 1] = std::numeric_limits<int>::max();
+                values[n / 2] = std::numeric_limits<int>::min();
+            }
+
+            long long total = 0;
+            size_t lowest = 0, highest = 0;
+            for (int i = 0; i < n; i++)
+            {
+                total += values[i];
+                if (values[i] < values[lowest]) lowest = i;
+                if (values[i] > values[highest]) highest = i;
+            }
+            assert(SimdKernels::sum(values.data(), n) == total);
+            assert(SimdKernels::argMin(values.data(), n) == (n ? lowest : 0));
+            assert(SimdKernels::argMax(values.data(), n) == (n ? highest : 0));
+        }
+    }
+    SimdKernels::select(SimdKernels::detected());
+
+    // Column reductions and the completion report match a scan of the views
+    SchedulerConfig config;
+    MLFQScheduler scheduler(config);
+    loadRandomWorkload(scheduler, 18, 2500);
+    scheduler.runUntil(4000);
+
+    auto checkReport = [](const MLFQScheduler& s)
+    {
+        CompletionReport report = s.getCompletionReport();
+        ProcessView maxWait, minTat, maxTat, maxResponse;
+        for (const auto& p : s.getAllProcesses())
+        {
+            if (p->getState() != ProcessState::TERMINATED) continue;
+            if (!maxWait || p->getWaitTime() > maxWait->getWaitTime()) maxWait = p;
+            if (!minTat || p->getTurnaroundTime() < minTat->getTurnaroundTime()) minTat = p;
+            if (!maxTat || p->getTurnaroundTime() > maxTat->getTurnaroundTime()) maxTat = p;
+            if (!maxResponse || p->getResponseTime() > maxResponse->getResponseTime()) maxResponse = p;
+        }
+        assert(report.maxWaitPid == maxWait->getPid() && report.maxWaitTime == maxWait->getWaitTime());
+        assert(report.minTurnaroundPid == minTat->getPid() && report.minTurnaroundTime == minTat->getTurnaroundTime());
+        assert(report.maxTurnaroundPid == maxTat->getPid() && report.maxTurnaroundTime == maxTat->getTurnaroundTime());
+        assert(report.maxResponsePid == maxResponse->getPid() && report.maxResponseTime == maxResponse->getResponseTime());
+    };
+    assert(!scheduler.isComplete());
+    checkReport(scheduler);
+    scheduler.runToCompletion();
+    checkReport(scheduler);
+
+    const ProcessTable& table = scheduler.getProcessTable();
+    ProcessSlot last = static_cast<ProcessSlot>(table.size());
+    long long wait = 0, turnaround = 0;
+    for (const auto& p : scheduler.getAllProcesses())
+    {
+        wait += p->getWaitTime();
+        turnaround += p->getTurnaroundTime();
+    }
+    assert(table.sumColumn(ProcessColumn::WAIT_TIME, 0, last) == wait);
+    assert(table.sumColumn(ProcessColumn::TURNAROUND_TIME, 0, last) == turnaround);
+    assert(table.sumColumn(ProcessColumn::REMAINING_TIME, 0, last) == 0);
+    assert(table.sumColumn(ProcessColumn::WAIT_TIME, 700, 1900) <= wait);
+    assert(table.argMaxColumn(ProcessColumn::WAIT_TIME, 5, 5) == NO_PROCESS);
+
+    // Nothing completed yet: report chunks are unallocated and read as 0
+    MLFQScheduler fresh(config);
+    loadRandomWorkload(fresh, 19, 1500);
+    const ProcessTable& pending = fresh.getProcessTable();
+    assert(fresh.getCompletionReport().maxWaitPid == -1);
+    assert(pending.sumColumn(ProcessColumn::TURNAROUND_TIME, 0, 1500) == 0);
+    assert(pending.argMinColumn(ProcessColumn::COMPLETION_TIME, 3, 1500) == 3);
+
+    std::cout << "PASSED\n";
+}
+
+void testScaleProfile()
+{
+    std::cout << "Testing Scale Profile... ";
+
+    // The scale profile only rejects nonsense, not large workloads
+    SchedulerConfig config = ConfigurationManager::getScaleProfile(50000000);
+    std::string error;
+    assert(config.validate(error));
+    SchedulerConfig demo = config;
+    demo.profile = ConfigProfile::DEMO;
+    assert(!demo.validate(error));
+    SchedulerConfig bad = config;
+    bad.numProcesses = 0;
+    assert(!bad.validate(error));
+    bad = config;
+    bad.maxBurstTime = SIM_TIME_MAX / 1000;   // Could not all finish in 64-bit time
+    assert(!bad.validate(error) && !error.empty());
+
+    // Times past 32 bits: arrivals days apart, bursts of hours (in microseconds)
+    const SimTime hour = 3600000000LL;
+    ReplayLog recording;
+    MLFQScheduler scheduler(config);
+    scheduler.reserve(3);
+    assert(scheduler.getProcessTable().capacity() >= 3);
+    scheduler.setRecorder(&recording);
+    scheduler.setLastQueueAlgorithm(LastQueueAlgorithm::SHORTEST_JOB_FIRST);
+    scheduler.addProcess(0, 5 * hour);
+    scheduler.addProcess(30 * hour, 2 * hour);
+    scheduler.addProcess(30 * hour + 1, 1500);
+    scheduler.runToCompletion();
+    assert(recording.finish(scheduler, error));
+
+    assert(scheduler.getCurrentTime() == 32 * hour + 1500);
+    for (const auto& p : scheduler.getCompletedProcesses())
+    {
+        assert(p->getTurnaroundTime() == p->getCompletionTime() - p->getArrivalTime());
+        assert(p->getWaitTime() == p->getTurnaroundTime() - p->getBurstTime());
+    }
+    assert(scheduler.getCompletedProcesses().back()->getCompletionTime() > std::numeric_limits<int>::max());
+    CompletionReport report = scheduler.getCompletionReport();
+    assert(report.maxTurnaroundPid == 1 && report.maxTurnaroundTime == 5 * hour);
+    assert(report.maxWaitPid == 3);   // Queued behind P2 after its first quantum
+
+    // 64-bit times survive the replay log encoding
+    ReplayLog loaded;
+    assert(loaded.deserialize(recording.serialize(), error));
+    assert(loaded.getConfig().boostInterval == config.boostInterval);
+    ReplayResult result = loaded.replay();
+    assert(result.matches && result.endTime == scheduler.getCurrentTime());
+
+    std::cout << "PASSED\n";
+}
+
+void testCompletedRetention()
+{
+    std::cout << "Testing Completed Retention... ";
+
+    // Jobs spread out in time, so early chunks empty out while later ones run
+    auto load = [](MLFQScheduler& s)
+    {
+        std::mt19937 gen(23);
+        std::uniform_int_distribution<> burstDist(1, 10);
+        for (int i = 0; i < 3000; i++)
+        {
+            s.addProcess(i * 8, burstDist(gen));
+        }
+    };
+    SchedulerConfig config;
+    config.numQueues = 4;
+    config.boostInterval = 50;
+
+    MLFQScheduler kept(config);
+    load(kept);
+    kept.runToCompletion();
+    auto expected = kept.getCompletedProcesses();
+    CompletionReport expectedReport = kept.getCompletionReport();
+
+    // Spilled processes leave the table and read back from the file
+    const char* path = "test_retention.bin";
+    std::string error;
+    MLFQScheduler spilled(config);
+    assert(spilled.setSpillFile(path, error));
+    load(spilled);
+    spilled.runUntil(12000);
+    SchedulerSnapshot midway = spilled.snapshot();
+    const ProcessTable& table = spilled.getProcessTable();
+    assert(spilled.getRetiredCount() > 1000 && table.isRetired(0));
+    assert(table.liveCount() + spilled.getRetiredCount() == 3000);
+    size_t live = 0;
+    for (const auto& p : spilled.getAllProcesses())
+    {
+        assert(p->getState() != ProcessState::TERMINATED);
+        live++;
+    }
+    assert(live == table.liveCount());
+
+    spilled.runToCompletion();
+    assert(spilled.isComplete() && spilled.getAllProcesses().empty());
+    {
+        auto actual = spilled.getCompletedProcesses();
+        assert(actual.size() == 3000 && expected.size() == 3000);
+        for (size_t i = 0; i < actual.size(); i++)
+        {
+            assert(actual[i].pid == expected[i].pid);
+            assert(actual[i].completionTime == expected[i].completionTime);
+            assert(actual[i].waitTime == expected[i].waitTime);
+            assert(actual[i].responseTime == expected[i].responseTime);
+        }
+    }
+    assert(spilled.getStats().completedProcesses == 3000);
+    assert(spilled.getStats().avgWaitTime == kept.getStats().avgWaitTime);
+    CompletionReport report = spilled.getCompletionReport();
+    assert(report.maxWaitPid == expectedReport.maxWaitPid && report.maxWaitTime == expectedReport.maxWaitTime);
+    assert(report.minTurnaroundPid == expectedReport.minTurnaroundPid);
+    assert(report.maxResponsePid == expectedReport.maxResponsePid);
+
+    // Restoring rewinds the file to the snapshot; the rerun spills the rest again
+    spilled.restore(midway);
+    assert(spilled.getCompletedProcesses().size() == spilled.getRetiredCount());
+    assert(spilled.getCompletedProcesses().size() < 3000);
+    spilled.runToCompletion();
+    assert(spilled.getCompletedProcesses().size() == 3000);
+    assert(spilled.getCompletedProcesses().back().pid == expected.back().pid);
+
+    // Snapshots keep reading their records when the writer rewinds past them:
+    // restoring an earlier state or resetting moves on to a new file
+    {
+        SchedulerSnapshot finished = spilled.snapshot();
+        spilled.restore(midway);
+        spilled.runUntil(14000);
+        MLFQScheduler reader(config);
+        reader.restore(finished);
+        spilled.reset();
+        load(spilled);
+        spilled.runUntil(4000);
+        auto kept = reader.getCompletedProcesses();
+        assert(kept.size() == 3000);
+        for (size_t i = 0; i < kept.size(); i += 7)
+        {
+            assert(kept[i].pid == expected[i].pid && kept[i].waitTime == expected[i].waitTime);
+        }
+        auto rerun = spilled.getCompletedProcesses();
+        assert(rerun.size() == spilled.getRetiredCount() && rerun.size() > 100);
+        assert(rerun.back().pid == expected[rerun.size() - 1].pid);
+    }
+    spilled.runToCompletion();
+    assert(spilled.getCompletedProcesses().size() == 3000);
+    assert(spilled.getCompletedProcesses()[2999].pid == expected[2999].pid);
+
+    // Discarding keeps only the running totals
+    MLFQScheduler discarded(config);
+    load(discarded);
+    discarded.runUntil(6000);
+    discarded.setRetention(CompletedRetention::DISCARD);  // Retires those kept so far
+    assert(discarded.getCompletedProcesses().empty());
+    discarded.runToCompletion();
+    assert(discarded.isComplete() && discarded.getStats().completedProcesses == 3000);
+    report = discarded.getCompletionReport();
+    assert(report.maxTurnaroundPid == expectedReport.maxTurnaroundPid);
+    assert(report.maxTurnaroundTime == expectedReport.maxTurnaroundTime);
+
+    std::remove(path);
+    std::cout << "PASSED\n";
+}
+
+void testPidControl()
+{
+    std::cout << "Testing Pid Control... ";
+
+    SchedulerConfig config;
+    config.numQueues = 2;
+    config.baseQuantum = 2;
+    config.boostInterval = 500;
+    ReplayLog recording;
+    MLFQScheduler scheduler(config);
+    scheduler.setRecorder(&recording);
+    scheduler.setLastQueueAlgorithm(LastQueueAlgorithm::SHORTEST_JOB_FIRST);
+    for (int i = 1; i <= 4; i++)
+    {
+        scheduler.addProcess(0, 10 * i);
+    }
+    scheduler.addProcess(1000, 5);
+
+    assert(scheduler.findProcess(3)->getBurstTime() == 30);
+    assert(!scheduler.findProcess(0) && !scheduler.findProcess(6));
+
+    // P1 runs from the SJF level with P2-P4 queued behind it
+    scheduler.runUntil(9);
+    const ProcessQueue& last = scheduler.getQueues()[1];
+    assert(scheduler.getCurrentProcess()->getPid() == 1 && last.size() == 3);
+    assert(last.peek() == scheduler.findProcess(2).getSlot());
+
+    // Shrinking P4's burst re-keys it to the front of the SJF heap
+    assert(!scheduler.setBurst(4, 2));     // Already ran 2 units
+    assert(!scheduler.setBurst(9, 5));
+    assert(scheduler.setBurst(4, 3));
+    assert(scheduler.findProcess(4)->getRemainingTime() == 1);
+    assert(last.peek() == scheduler.findProcess(4).getSlot());
+
+    // Cancel the running process, a queued one and one yet to arrive
+    assert(scheduler.cancelProcess(1) && !scheduler.getCurrentProcess());
+    assert(scheduler.cancelProcess(3) && last.size() == 2);
+    assert(scheduler.cancelProcess(5));
+    assert(!scheduler.cancelProcess(5) && !scheduler.findProcess(5));
+    assert(scheduler.getCancelledCount() == 3);
+
+    // The run ends with P2, not at the cancelled arrival
+    scheduler.runToCompletion();
+    std::string error;
+    assert(recording.finish(scheduler, error));
+    const auto& completed = scheduler.getCompletedProcesses();
+    assert(completed.size() == 2 && completed[0].pid == 4 && completed[1].pid == 2);
+    assert(scheduler.isComplete() && scheduler.getCurrentTime() == 28);
+    assert(scheduler.getStats().totalProcesses == 2);
+    assert(!scheduler.cancelProcess(2));   // Already completed
+
+    // Cancellations and burst changes replay
+    ReplayLog loaded;
+    assert(loaded.deserialize(recording.serialize(), error));
+    assert(loaded.replay().matches);
+
+    std::cout << "PASSED\n";
+}
+
+void testTimeResolution()
+{
+    std::cout << "Testing Time Resolution... ";
+
+    SimTime ns = 0;
+    std::string error;
+    assert(parseDuration("250us", ns, error) && ns == 250 * TIME_US);
+    assert(parseDuration("1.5ms", ns, error) && ns == 1500000);
+    assert(parseDuration("2h", ns, error) && ns == 2 * TIME_H);
+    assert(parseDuration("3min", ns, error) && ns == 180 * TIME_S);
+    assert(!parseDuration("5", ns, error) && !parseDuration("-1ms", ns, error));
+    assert(!parseDuration("ms", ns, error) && !parseDuration("1e30h", ns, error));
+    assert(formatDuration(1500000) == "1.5 ms" && formatDuration(999) == "999 ns");
+    assert(formatDuration(2 * TIME_H) == "2 h" && formatDuration(0) == "0 ns");
+
+    // Real durations round up to whole ticks
+    SchedulerConfig us;
+    us.tickLength = TIME_US;
+    assert(us.toTicks(1500) == 2 && us.toTicks(2000) == 2 && us.toTicks(0) == 0);
+    assert(us.toNanoseconds(3) == 3000 && us.toNanoseconds(SIM_TIME_MAX) == SIM_TIME_MAX);
+    assert(!us.validate(error));     // The demo ranges are in milliseconds
+
+    // Nanosecond ticks: the scale profile keeps its quanta in real units
+    SchedulerConfig config = ConfigurationManager::getScaleProfile(10000, TIME_NS);
+    assert(config.validate(error));
+    assert(config.baseQuantum == TIME_MS && config.boostInterval == TIME_S);
+    assert(config.maxArrivalTime == 24 * TIME_H);
+    assert(ConfigurationManager::getScaleProfile(10000).baseQuantum == 1000);
+
+    // Microsecond RPC handlers beside an hour-long batch job: each slice is
+    // one event, so 3.6e12 ticks take one log record per slice (the batch
+    // job is boosted every second and works its way down again)
+    MLFQScheduler scheduler(config);
+    ReplayLog recording;
+    scheduler.setRecorder(&recording);
+    scheduler.addProcess(0, TIME_H);
+    for (int i = 1; i <= 1000; i++)
+    {
+        scheduler.addProcess(i * 100 * TIME_MS + 7, 20 * TIME_US + i);
+    }
+    scheduler.runToCompletion();
+    assert(recording.finish(scheduler, error));
+
+    SimTime rpcWork = 1000 * 20 * TIME_US + 1000 * 1001 / 2;
+    assert(scheduler.getCurrentTime() == TIME_H + rpcWork);
+    assert(scheduler.getExecutionLog().size() < 50000);
+    for (const auto& p : scheduler.getCompletedProcesses())
+    {
+        assert(p.pid == 1 || p.waitTime < 20 * TIME_S);   // At most one batch quantum
+    }
+
+    // The tick length travels with the recording
+    ReplayLog loaded;
+    assert(loaded.deserialize(recording.serialize(), error));
+    assert(loaded.getConfig().tickLength == TIME_NS && loaded.replay().matches);
+
+    std::cout << "PASSED\n";
+}
+
+// Checks that every dispatch ends in exactly one completion, preemption or
+// demotion, and counts each kind of event
+class EventCounter : public SchedulerObserver
+{
+public:
+    int arrivals = 0, dispatches = 0, preemptions = 0, demotions = 0, boosts = 0;
+    std::vector<int> completed;
+    int running = -1;
+
+    void onArrival(const ProcessView& p, SimTime time) override
+    {
+        assert(p->getArrivalTime() == time);
+        arrivals++;
+    }
+    void onDispatch(const ProcessView& p, int level, SimTime) override
+    {
+        assert(running < 0 && p->getPriority() == level);
+        running = p->getPid();
+        dispatches++;
+    }
+    void onPreemption(const ProcessView& p, int, SimTime) override
+    {
+        assert(running == p->getPid());
+        running = -1;
+        preemptions++;
+    }
+    void onDemotion(const ProcessView& p, int from, int to, SimTime) override
+    {
+        assert(running == p->getPid() && to == from + 1 && p->getPriority() == to);
+        running = -1;
+        demotions++;
+    }
+    void onBoost(SimTime) override { boosts++; }
+    void onCompletion(const ProcessView& p, SimTime time) override
+    {
+        assert(running == p->getPid() && p->getCompletionTime() == time);
+        running = -1;
+        completed.push_back(p->getPid());
+    }
+};
+
+struct CompletionHooks : NoSchedulerHooks
+{
+    std::vector<int> completed;
+    void onCompletion(const ProcessView& p, SimTime) { completed.push_back(p->getPid()); }
+};
+
+void testSchedulerHooks()
+{
+    std::cout << "Testing Scheduler Hooks... ";
+
+    SchedulerConfig config;
+    config.boostInterval = 40;
+    MLFQScheduler scheduler(config);
+    scheduler.setLastQueueAlgorithm(LastQueueAlgorithm::SHORTEST_JOB_FIRST);
+    for (int i = 0; i < 12; i++)
+    {
+        scheduler.addProcess(i * 3, 5 + (i * 7) % 23);
+    }
+    MLFQScheduler unobserved = scheduler.fork();
+
+    // Runtime observer, through single steps and a bulk run without logging
+    EventCounter counter;
+    scheduler.setObserver(&counter);
+    assert(scheduler.fork().getObserver() == nullptr);   // Not copied
+    scheduler.runSteps(0);
+    for (int i = 0; i < 25; i++)
+    {
+        scheduler.step();
+    }
+    scheduler.setExecutionLogging(false);
+    scheduler.runToCompletion();
+
+    long long dispatches = 0;
+    for (const auto& q : scheduler.getQueueStats())
+    {
+        dispatches += q.dispatches;
+    }
+    assert(counter.arrivals == 12 && counter.completed.size() == 12);
+    assert(counter.dispatches == dispatches && counter.running < 0);
+    assert(counter.dispatches == 12 + counter.preemptions + counter.demotions);
+    assert(counter.demotions > 0 && counter.preemptions > 0 && counter.boosts > 0);
+    for (size_t i = 0; i < 12; i++)
+    {
+        assert(scheduler.getCompletedProcesses()[i].pid == counter.completed[i]);
+    }
+
+    // Compile-time hooks see the same schedule; detaching stops the calls
+    CompletionHooks hooks;
+    unobserved.runUntil(30, hooks);
+    unobserved.runToCompletion(hooks);
+    assert(hooks.completed == counter.completed);
+    assert(unobserved.getCurrentTime() == scheduler.getCurrentTime());
+
+    scheduler.setObserver(nullptr);
+    scheduler.reset();
+    scheduler.addProcess(0, 5);
+    scheduler.runToCompletion();
+    assert(counter.completed.size() == 12);
+
+    std::cout << "PASSED\n";
+}
+
+void testLoadWorkload()
+{
+    std::cout << "Testing Load Workload... ";
+
+    // Unsorted arrivals with ties, spread over more than one radix digit
+    std::mt19937_64 gen(11);
+    std::uniform_int_distribution<SimTime> arrivalDist(0, 5000000);
+    std::uniform_int_distribution<SimTime> burstDist(1, 2000);
+    std::vector<JobSpec> jobs(6000);
+    for (auto& job : jobs)
+    {
+        job.arrivalTime = arrivalDist(gen) / 1000 * 1000;
+        job.burstTime = burstDist(gen);
+    }
+    std::vector<JobSpec> late = {{40, 7}, {0, 3}, {60000, 9}, {60000, 4}, {2500000, 5}};
+
+    SchedulerConfig config = ConfigurationManager::getScaleProfile(jobs.size());
+    MLFQScheduler one(config);
+    MLFQScheduler bulk(config);
+    ReplayLog recording;
+    bulk.setRecorder(&recording);
+    for (MLFQScheduler* s : {&one, &bulk})
+    {
+        s->setLastQueueAlgorithm(LastQueueAlgorithm::SHORTEST_JOB_FIRST);
+        s->addProcess(60000, 10);
+        s->addProcess(80000, 10);
+        s->addProcess(90000, 10);
+        s->runUntil(50000);
+        s->cancelProcess(2);
+    }
+
+    // Loaded mid-run: some arrivals already past, some tied with pending ones
+    for (const auto& job : jobs)
+    {
+        one.addProcess(job.arrivalTime, job.burstTime);
+    }
+    for (const auto& job : late)
+    {
+        one.addProcess(job.arrivalTime, job.burstTime);
+    }
+    bulk.loadWorkload(jobs);
+    bulk.loadWorkload(late.data(), late.size());
+    bulk.loadWorkload(nullptr, 0);
+    assert(bulk.getProcessTable().size() == one.getProcessTable().size());
+    assert(bulk.findProcess(4)->getArrivalTime() == jobs[0].arrivalTime);
+
+    one.runToCompletion();
+    bulk.runToCompletion();
+    std::string error;
+    assert(recording.finish(bulk, error));
+    assert(bulk.getCurrentTime() == one.getCurrentTime());
+    assert(bulk.getExecutionLog().size() == one.getExecutionLog().size());
+    for (size_t i = 0; i < one.getExecutionLog().size(); i++)
+    {
+        assert(bulk.getExecutionLog()[i].pid == one.getExecutionLog()[i].pid);
+        assert(bulk.getExecutionLog()[i].endTime == one.getExecutionLog()[i].endTime);
+    }
+    assert(bulk.getCompletedProcesses().size() == jobs.size() + late.size() + 2);
+
+    // Loads are recorded as the individual additions
+    assert(recording.replay().matches);
+
+    // Arrivals too far apart to pack beside their index sort as pairs
+    MLFQScheduler wide(config);
+    const SimTime far = SimTime(1) << 62;
+    std::vector<JobSpec> spread = {{far + 5, 1}, {0, 1}, {far, 1}, {3, 1}, {far, 2}};
+    wide.loadWorkload(spread);
+    wide.runToCompletion();
+    const auto& order = wide.getCompletedProcesses();
+    assert(order.size() == 5 && order[0].pid == 2 && order[1].pid == 4);
+    assert(order[2].pid == 3 && order[3].pid == 5 && order[4].pid == 1);
+
+    std::cout << "PASSED\n";
+}
+
+void testConcurrentSubmission()
+{
+    std::cout << "Testing Concurrent Submission... ";
+
+    // Submitted jobs join at the next step, recorded like addProcess()
+    ReplayLog recording;
+    MLFQScheduler scheduler;
+    scheduler.setRecorder(&recording);
+    scheduler.addProcess(0, 6);
+    scheduler.submit(0, 3);
+    assert(scheduler.getProcessTable().size() == 1);
+    scheduler.step();
+    assert(scheduler.getProcessTable().size() == 2);
+    scheduler.runUntil(4);
+    scheduler.submit(2, 2);     // Already past: admitted when accepted
+    scheduler.submit(20, 1);
+    scheduler.runToCompletion();
+    std::string error;
+    assert(recording.finish(scheduler, error));
+    assert(scheduler.getCompletedProcesses().size() == 4);
+    assert(scheduler.findProcess(3)->getArrivalTime() == 2);
+    assert(recording.replay().matches);
+
+    // Producers on several threads feed a run in progress
+    const int producers = 4;
+    const int perProducer = 5000;
+    MLFQScheduler live(ConfigurationManager::getScaleProfile(producers * perProducer));
+    std::atomic<int> finished(0);
+    std::vector<std::thread> feeders;
+    for (int p = 0; p < producers; p++)
+    {
+        feeders.emplace_back([&live, &finished, p]()
+        {
+            for (int i = 0; i < perProducer; i++)
+            {
+                live.submit(SimTime(i) * producers + p, 3);   // Arrival encodes the sender
+            }
+            finished++;
+        });
+    }
+    while (finished.load() < producers)
+    {
+        live.stepEvent();
+    }
+    for (auto& feeder : feeders)
+    {
+        feeder.join();
+    }
+    live.runToCompletion();
+
+    SchedulerStats stats = live.getStats();
+    assert(stats.completedProcesses == size_t(producers * perProducer));
+    assert(stats.cpuBusyTime == 3LL * producers * perProducer);
+    std::vector<SimTime> lastSent(producers, -1);
+    for (const auto& process : live.getAllProcesses())
+    {
+        SimTime arrival = process->getArrivalTime();
+        SimTime& last = lastSent[arrival % producers];
+        assert(arrival > last);    // Each sender's jobs keep their order
+        last = arrival;
+    }
+
+    std::cout << "PASSED\n";
+}
+
 void runAllTests() {
     std::cout << "\n========================================\n";
     std::cout << "    MLFQ Scheduler Unit Tests\n";
@@ -117,9 +1800,37 @@ void runAllTests() {
     
     testProcessCreation();
     testQueueOperations();
+    testOrderedQueue();
+    testIntrusiveQueue();
+    testLazyBoost();
+    testBoostKeepsArrivalTies();
+    testProcessTableViews();
+    testReportColumns();
+    testDeepQueueLevels();
     testSchedulerBasics();
     testSchedulerCompletion();
     testMetricsCalculation();
+    testStreamingStats();
+    testEventEngineMatchesTicks();
+    testArrivalOrdering();
+    testLazyWaitAccounting();
+    testExecutionLogCompression();
+    testGoldenSchedules();
+    testTableReuse();
+    testBulkRun();
+    testTypedQueuePolicies();
+    testSingleCoreMatchesScheduler();
+    testMultiCoreStealing();
+    testSnapshotFork();
+    testReplayLog();
+    testSimdKernels();
+    testScaleProfile();
+    testCompletedRetention();
+    testPidControl();
+    testTimeResolution();
+    testSchedulerHooks();
+    testLoadWorkload();
+    testConcurrentSubmission();
     
     std::cout << "\n========================================\n";
     std::cout << "    All Tests PASSED!\n";